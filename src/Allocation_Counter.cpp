@@ -0,0 +1,99 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Replacing the global operator new / delete only happens when tracking is enabled,
+ * release builds keep the standard library's versions.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Allocation_Counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+std::atomic<size_t> Allocation_Counter_NS::allocation_count{0};
+
+#if ALLOCATION_COUNTER_ENABLED
+
+/**
+ * Allocate size bytes with the given alignment, counting the allocation
+ * @param size Number of bytes
+ * @param alignment Required alignment, 0 for the default
+ * @returns Returns a pointer to the memory, or NULL if the allocation failed
+ */
+static void* counted_allocate(size_t size, size_t alignment) {
+
+    Allocation_Counter_NS::record();
+
+    if (size == 0) { size = 1; }
+
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return malloc(size);
+    }
+
+    // aligned_alloc requires the size to be a multiple of the alignment
+    return aligned_alloc(alignment, ((size + alignment - 1) / alignment) * alignment);
+}
+
+void* operator new(size_t size) {
+
+    void* target = counted_allocate(size, 0);
+    if (target == NULL) { throw std::bad_alloc(); }
+    return target;
+}
+
+void* operator new[](size_t size) {
+
+    void* target = counted_allocate(size, 0);
+    if (target == NULL) { throw std::bad_alloc(); }
+    return target;
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+
+    void* target = counted_allocate(size, (size_t)alignment);
+    if (target == NULL) { throw std::bad_alloc(); }
+    return target;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+
+    void* target = counted_allocate(size, (size_t)alignment);
+    if (target == NULL) { throw std::bad_alloc(); }
+    return target;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+
+    return counted_allocate(size, 0);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+
+    return counted_allocate(size, 0);
+}
+
+void operator delete(void* target) noexcept { free(target); }
+void operator delete[](void* target) noexcept { free(target); }
+void operator delete(void* target, size_t) noexcept { free(target); }
+void operator delete[](void* target, size_t) noexcept { free(target); }
+void operator delete(void* target, std::align_val_t) noexcept { free(target); }
+void operator delete[](void* target, std::align_val_t) noexcept { free(target); }
+void operator delete(void* target, size_t, std::align_val_t) noexcept { free(target); }
+void operator delete[](void* target, size_t, std::align_val_t) noexcept { free(target); }
+void operator delete(void* target, const std::nothrow_t&) noexcept { free(target); }
+void operator delete[](void* target, const std::nothrow_t&) noexcept { free(target); }
+
+#endif
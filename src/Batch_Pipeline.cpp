@@ -0,0 +1,202 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Batch_Pipeline.hpp"
+
+using Batch_Pipeline_NS::Batch_Pipeline;
+using Batch_Pipeline_NS::Batch_Pipeline_Slot;
+
+/* Sequence value that tells waiting loaders to stop */
+#define BATCH_PIPELINE_SHUTDOWN ((size_t)-1)
+/* Number of times acquire() yields before blocking on a batch that isn't ready */
+#define BATCH_PIPELINE_YIELDS 16
+
+Batch_Pipeline::Batch_Pipeline(const MNIST_Utils_NS::MNIST_Images& images, const MNIST_Utils_NS::MNIST_Labels& labels,
+    size_t batch_size, const size_t* schedule, size_t num_batches, size_t num_loaders, size_t num_slots) :
+    m_images(images), m_labels(labels) {
+
+    // With one slot, "batch k ready" (k + 1) would equal "slot free for batch k + 1" (k + num_slots),
+    // letting a loader overwrite the batch the trainer is still using
+    if (batch_size == 0 || num_loaders == 0 || num_slots < 2) {
+        Log::log_message(Log::Log_Priority::ERROR, "Batch_Pipeline::Batch_Pipeline",
+            std::format("Invalid setup: batch size {}, {} loaders, {} slots", batch_size, num_loaders, num_slots));
+        exit(EXIT_FAILURE);
+    }
+    if (schedule == NULL && num_batches != 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Batch_Pipeline::Batch_Pipeline",
+            "Invalid schedule provided");
+        exit(EXIT_FAILURE);
+    }
+
+    m_batch_size = batch_size;
+    m_num_batches = num_batches;
+    m_num_slots = num_slots;
+
+    const size_t schedule_size = num_batches * batch_size;
+
+    for (size_t i = 0; i < schedule_size; ++i) {
+        if (schedule[i] >= images.size() || schedule[i] >= labels.size()) {
+            Log::log_message(Log::Log_Priority::ERROR, "Batch_Pipeline::Batch_Pipeline",
+                std::format("Image {} is past the end of the dataset", schedule[i]));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    m_schedule = (size_t*)calloc(schedule_size + 1, sizeof(size_t));
+    if (m_schedule == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Batch_Pipeline::Batch_Pipeline",
+            "Unable to allocate memory for the schedule");
+        exit(EXIT_FAILURE);
+    }
+    if (num_batches != 0) {
+        memcpy(m_schedule, schedule, schedule_size * sizeof(size_t));
+    }
+
+    // All batch memory is allocated here, so the loaders and the trainer never allocate
+    m_slots = new Batch_Pipeline_Slot[num_slots];
+    for (size_t i = 0; i < num_slots; ++i) {
+        if (images.format() == MNIST_Utils_NS::Pixel_Format::RAW) {
+            m_slots[i].raw_images = new Byte_Matrix(MNIST_IMAGE_SIZE, batch_size);
+        }
+        else {
+            m_slots[i].images = new Matrix(MNIST_IMAGE_SIZE, batch_size);
+        }
+        m_slots[i].labels = new Matrix(MNIST_LABELS, batch_size);
+        // Slot i is first filled with batch i
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // No point starting loaders that would never get a batch
+    if (num_loaders > num_batches) {
+        num_loaders = (num_batches == 0) ? 0 : num_batches;
+    }
+
+    for (size_t i = 0; i < num_loaders; ++i) {
+        m_loaders.emplace_back(&Batch_Pipeline::loader_loop, this, i, num_loaders);
+    }
+}
+
+Batch_Pipeline::~Batch_Pipeline() {
+
+    // Loaders that are still waiting on a slot see the sentinel and exit
+    for (size_t i = 0; i < m_num_slots; ++i) {
+        m_slots[i].sequence.store(BATCH_PIPELINE_SHUTDOWN, std::memory_order_release);
+        m_slots[i].sequence.notify_all();
+    }
+
+    for (size_t i = 0; i < m_loaders.size(); ++i) {
+        m_loaders[i].join();
+    }
+
+    for (size_t i = 0; i < m_num_slots; ++i) {
+        delete m_slots[i].images;
+        delete m_slots[i].raw_images;
+        delete m_slots[i].labels;
+    }
+    delete[] m_slots;
+    free(m_schedule);
+}
+
+void Batch_Pipeline::loader_loop(size_t loader, size_t num_loaders) {
+
+    for (size_t k = loader; k < m_num_batches; k += num_loaders) {
+
+        Batch_Pipeline_Slot& slot = m_slots[k % m_num_slots];
+
+        // Wait for the trainer to hand back batch k - num_slots
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        while (sequence != k) {
+            if (sequence == BATCH_PIPELINE_SHUTDOWN) {
+                return;
+            }
+            slot.sequence.wait(sequence, std::memory_order_acquire);
+            sequence = slot.sequence.load(std::memory_order_acquire);
+        }
+
+        const size_t* indices = m_schedule + (k * m_batch_size);
+        if (slot.raw_images != NULL) {
+            m_images.gather_images(indices, m_batch_size, *(slot.raw_images));
+        }
+        else {
+            m_images.gather_images(indices, m_batch_size, *(slot.images));
+        }
+        m_labels.gather_labels(indices, m_batch_size, *(slot.labels));
+        slot.batch = k;
+
+        // Publish. The trainer might not be waiting, but notify is cheap when nobody is
+        if (slot.sequence.compare_exchange_strong(sequence, k + 1, std::memory_order_release)) {
+            slot.sequence.notify_all();
+        }
+        else {
+            // Only the destructor can change the sequence under us
+            return;
+        }
+    }
+}
+
+const Batch_Pipeline_Slot& Batch_Pipeline::acquire(void) {
+
+    if (m_next_batch >= m_num_batches) {
+        Log::log_message(Log::Log_Priority::ERROR, "Batch_Pipeline::acquire",
+            std::format("All {} batches have already been acquired", m_num_batches));
+        exit(EXIT_FAILURE);
+    }
+
+    Batch_Pipeline_Slot& slot = m_slots[m_next_batch % m_num_slots];
+
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != m_next_batch + 1) {
+        ++m_stalls;
+        // Small batches are usually only a moment away, so give the loaders a chance before sleeping
+        for (size_t i = 0; i < BATCH_PIPELINE_YIELDS && sequence != m_next_batch + 1; ++i) {
+            std::this_thread::yield();
+            sequence = slot.sequence.load(std::memory_order_acquire);
+        }
+        while (sequence != m_next_batch + 1) {
+            slot.sequence.wait(sequence, std::memory_order_acquire);
+            sequence = slot.sequence.load(std::memory_order_acquire);
+        }
+    }
+
+    return slot;
+}
+
+void Batch_Pipeline::release(void) {
+
+    Batch_Pipeline_Slot& slot = m_slots[m_next_batch % m_num_slots];
+
+    if (slot.sequence.load(std::memory_order_relaxed) != m_next_batch + 1) {
+        Log::log_message(Log::Log_Priority::ERROR, "Batch_Pipeline::release",
+            "release() called without a matching acquire()");
+        exit(EXIT_FAILURE);
+    }
+
+    // The slot's next batch is num_slots further along
+    slot.sequence.store(m_next_batch + m_num_slots, std::memory_order_release);
+    slot.sequence.notify_all();
+    ++m_next_batch;
+}
+
+size_t Batch_Pipeline::remaining(void) const {
+
+    return m_num_batches - m_next_batch;
+}
+
+size_t Batch_Pipeline::stalls(void) const {
+
+    return m_stalls;
+}
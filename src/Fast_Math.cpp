@@ -0,0 +1,218 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * The FAST array functions are plain loops over the inline scalar approximations in
+ * Fast_Math.hpp. Those are branch-free, so the compiler vectorizes each loop; we build
+ * one copy per instruction set with target attributes and pick the copy matching the
+ * instruction set Matrix_Kernels selected.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Fast_Math.hpp"
+#include "include/Matrix_Kernels.hpp"
+
+#include <math.h>
+
+using Fast_Math_NS::Math_Precision;
+using Matrix_Kernels_NS::Instruction_Set;
+
+static Math_Precision active_precision = Math_Precision::FAST;
+
+/* Exact versions, one libm call per element */
+
+static void exp_exact(const float* source, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = expf(source[i]); }
+}
+
+static void log_exact(const float* source, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = logf(source[i]); }
+}
+
+static void log10_exact(const float* source, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = log10f(source[i]); }
+}
+
+static void sigmoid_exact(const float* source, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = 1.0f / (1.0f + expf(-source[i])); }
+}
+
+static void bias_sigmoid_exact(float* z, const float* bias, size_t rows, size_t cols, float* destination) {
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            const float value = z[(i * cols) + j] + bias[i];
+            z[(i * cols) + j] = value;
+            destination[(i * cols) + j] = 1.0f / (1.0f + expf(-value));
+        }
+    }
+}
+
+/* Fast versions. The loop bodies are identical across instruction sets, only the target changes */
+
+#define FAST_MATH_LOOPS(SUFFIX, TARGET) \
+    TARGET static void exp_##SUFFIX(const float* source, float* destination, size_t elements) { \
+        for (size_t i = 0; i < elements; ++i) { destination[i] = Fast_Math_NS::fast_exp(source[i]); } \
+    } \
+    TARGET static void log_##SUFFIX(const float* source, float* destination, size_t elements) { \
+        for (size_t i = 0; i < elements; ++i) { destination[i] = Fast_Math_NS::fast_log(source[i]); } \
+    } \
+    TARGET static void log10_##SUFFIX(const float* source, float* destination, size_t elements) { \
+        for (size_t i = 0; i < elements; ++i) { \
+            destination[i] = Fast_Math_NS::fast_log(source[i]) * 0.434294481903251828f; \
+        } \
+    } \
+    TARGET static void sigmoid_##SUFFIX(const float* source, float* destination, size_t elements) { \
+        for (size_t i = 0; i < elements; ++i) { destination[i] = Fast_Math_NS::fast_sigmoid(source[i]); } \
+    } \
+    TARGET static void bias_sigmoid_##SUFFIX(float* z, const float* bias, size_t rows, size_t cols, \
+        float* destination) { \
+        /* Separate loop nests for the in-place and split cases, so neither needs an alias check */ \
+        if (destination == z) { \
+            for (size_t i = 0; i < rows; ++i) { \
+                float* row = z + (i * cols); \
+                const float b = bias[i]; \
+                for (size_t j = 0; j < cols; ++j) { row[j] = Fast_Math_NS::fast_sigmoid(row[j] + b); } \
+            } \
+            return; \
+        } \
+        for (size_t i = 0; i < rows; ++i) { \
+            float* __restrict z_row = z + (i * cols); \
+            float* __restrict destination_row = destination + (i * cols); \
+            const float b = bias[i]; \
+            for (size_t j = 0; j < cols; ++j) { \
+                const float value = z_row[j] + b; \
+                z_row[j] = value; \
+                destination_row[j] = Fast_Math_NS::fast_sigmoid(value); \
+            } \
+        } \
+    } \
+    TARGET static void multiply_sigmoid_prime_##SUFFIX(const float* source, const float* outputs, \
+        float* destination, size_t elements) { \
+        for (size_t i = 0; i < elements; ++i) { destination[i] = source[i] * outputs[i] * (1.0f - outputs[i]); } \
+    }
+
+FAST_MATH_LOOPS(baseline, )
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FAST_MATH_X86 1
+FAST_MATH_LOOPS(avx2, __attribute__((target("avx2,fma"))))
+FAST_MATH_LOOPS(avx512, __attribute__((target("avx512f"))))
+
+/**
+ * Check for FMA, which the AVX2 loops are compiled with but Matrix_Kernels does not test for
+ * @returns Returns true if the CPU supports FMA
+ */
+static bool detect_fma(void) {
+
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma");
+}
+
+/* Some AVX2 hosts and VMs lack FMA. Anything running before this is initialized falls back to
+ * the baseline loops */
+static const bool fma_supported = detect_fma();
+#else
+#define FAST_MATH_X86 0
+#endif
+
+typedef void (*Array_Function)(const float* source, float* destination, size_t elements);
+
+typedef void (*Bias_Function)(float* z, const float* bias, size_t rows, size_t cols, float* destination);
+typedef void (*Derivative_Function)(const float* source, const float* outputs, float* destination, size_t elements);
+
+typedef struct {
+    Array_Function exp;
+    Array_Function log;
+    Array_Function log10;
+    Array_Function sigmoid;
+    Bias_Function bias_sigmoid;
+    Derivative_Function multiply_sigmoid_prime;
+} Math_Table;
+
+/* The derivative from the output has no approximation in it, so EXACT shares the baseline loop */
+static const Math_Table EXACT_TABLE = {
+    exp_exact, log_exact, log10_exact, sigmoid_exact, bias_sigmoid_exact, multiply_sigmoid_prime_baseline
+};
+static const Math_Table BASELINE_TABLE = {
+    exp_baseline, log_baseline, log10_baseline, sigmoid_baseline, bias_sigmoid_baseline,
+    multiply_sigmoid_prime_baseline
+};
+#if FAST_MATH_X86
+static const Math_Table AVX2_TABLE = {
+    exp_avx2, log_avx2, log10_avx2, sigmoid_avx2, bias_sigmoid_avx2, multiply_sigmoid_prime_avx2
+};
+static const Math_Table AVX512_TABLE = {
+    exp_avx512, log_avx512, log10_avx512, sigmoid_avx512, bias_sigmoid_avx512, multiply_sigmoid_prime_avx512
+};
+#endif
+
+/**
+ * Pick the table for the active precision and the instruction set chosen by Matrix_Kernels
+ * @returns Returns the Math_Table to use
+ */
+static const Math_Table& table(void) {
+
+    if (active_precision == Math_Precision::EXACT) { return EXACT_TABLE; }
+
+#if FAST_MATH_X86
+    switch (Matrix_Kernels_NS::kernels().instruction_set) {
+        case Instruction_Set::AVX512: return AVX512_TABLE;
+        case Instruction_Set::AVX2: return fma_supported ? AVX2_TABLE : BASELINE_TABLE;
+        default: break;
+    }
+#endif
+
+    return BASELINE_TABLE;
+}
+
+void Fast_Math_NS::set_precision(Math_Precision precision) {
+
+    active_precision = precision;
+}
+
+Math_Precision Fast_Math_NS::get_precision(void) {
+
+    return active_precision;
+}
+
+void Fast_Math_NS::exp(const float* source, float* destination, size_t elements) {
+
+    table().exp(source, destination, elements);
+}
+
+void Fast_Math_NS::log(const float* source, float* destination, size_t elements) {
+
+    table().log(source, destination, elements);
+}
+
+void Fast_Math_NS::log10(const float* source, float* destination, size_t elements) {
+
+    table().log10(source, destination, elements);
+}
+
+void Fast_Math_NS::sigmoid(const float* source, float* destination, size_t elements) {
+
+    table().sigmoid(source, destination, elements);
+}
+
+void Fast_Math_NS::bias_sigmoid(float* z, const float* bias, size_t rows, size_t cols, float* destination) {
+
+    table().bias_sigmoid(z, bias, rows, cols, destination);
+}
+
+void Fast_Math_NS::multiply_sigmoid_prime(const float* source, const float* outputs, float* destination,
+    size_t elements) {
+
+    table().multiply_sigmoid_prime(source, outputs, destination, elements);
+}
@@ -0,0 +1,171 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Inference_Context.hpp"
+
+using Inference_Context_NS::Inference_Context;
+
+/**
+ * Round a number of floats up so the next buffer starts on an alignment boundary
+ * @param elements Number of floats
+ * @returns Returns the padded number of floats
+ */
+static size_t aligned_elements(size_t elements) {
+
+    const size_t per_line = INFERENCE_CONTEXT_ALIGNMENT / sizeof(float);
+    return ((elements + per_line - 1) / per_line) * per_line;
+}
+
+Inference_Context::Inference_Context(const std::vector<size_t>& layer_info, size_t max_batch_size) {
+
+    if (layer_info.size() < 2 || max_batch_size == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Context::Inference_Context",
+            "An inference context needs at least two layers and a non-zero batch size");
+        exit(EXIT_FAILURE);
+    }
+
+    m_layer_info = layer_info;
+    m_batch_size = max_batch_size;
+
+    m_views = (Matrix**)calloc(m_layer_info.size(), sizeof(Matrix*));
+    if (m_views == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Context::Inference_Context",
+            "Unable to allocate memory for the inference context views");
+        exit(EXIT_FAILURE);
+    }
+
+    // Create the views up front. They get pointed at the arena in bind_views
+    for (size_t i = 0; i < m_layer_info.size(); ++i) {
+        m_views[i] = new Matrix(0, 0, NULL);
+    }
+
+    allocate(max_batch_size);
+}
+
+Inference_Context::~Inference_Context() {
+
+    if (m_views != NULL) {
+        for (size_t i = 0; i < m_layer_info.size(); ++i) {
+            if (m_views[i] != NULL) { delete m_views[i]; }
+        }
+        free(m_views);
+        m_views = NULL;
+    }
+
+    if (m_arena != NULL) {
+        free(m_arena);
+        m_arena = NULL;
+    }
+}
+
+void Inference_Context::allocate(size_t max_batch_size) {
+
+    // Both buffers are sized for the widest layer after the input
+    size_t max_neurons = 0;
+    for (size_t i = 1; i < m_layer_info.size(); ++i) {
+        max_neurons = (m_layer_info[i] > max_neurons) ? m_layer_info[i] : max_neurons;
+    }
+
+    // Two activation buffers followed by the single-sample input staging buffer
+    const size_t elements = (2 * aligned_elements(max_neurons * max_batch_size)) + aligned_elements(m_layer_info[0]);
+
+    if (m_arena != NULL) { free(m_arena); }
+
+    m_arena = (float*)aligned_alloc(INFERENCE_CONTEXT_ALIGNMENT, elements * sizeof(float));
+    Allocation_Counter_NS::record();
+
+    if (m_arena == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Context::allocate",
+            std::format("Unable to allocate {} bytes for the inference context arena", elements * sizeof(float)));
+        exit(EXIT_FAILURE);
+    }
+
+    memset(m_arena, '\0', elements * sizeof(float));
+    m_max_batch_size = max_batch_size;
+
+    bind_views();
+}
+
+void Inference_Context::bind_views(void) {
+
+    size_t max_neurons = 0;
+    for (size_t i = 1; i < m_layer_info.size(); ++i) {
+        max_neurons = (m_layer_info[i] > max_neurons) ? m_layer_info[i] : max_neurons;
+    }
+
+    // Odd layers write the first buffer and even layers the second, so a layer never
+    // overwrites the activations it is reading
+    float* buffers[2] = { m_arena, m_arena + aligned_elements(max_neurons * m_max_batch_size) };
+
+    for (size_t i = 1; i < m_layer_info.size(); ++i) {
+        m_views[i]->rebind(m_layer_info[i], m_batch_size, buffers[(i - 1) % 2]);
+    }
+
+    m_views[0]->rebind(m_layer_info[0], 1, buffers[1] + aligned_elements(max_neurons * m_max_batch_size));
+}
+
+size_t Inference_Context::batch_size(void) const {
+
+    return m_batch_size;
+}
+
+size_t Inference_Context::num_layers(void) const {
+
+    return m_layer_info.size();
+}
+
+size_t Inference_Context::layer_size(size_t layer) const {
+
+    return m_layer_info[layer];
+}
+
+bool Inference_Context::resize(size_t batch_size) {
+
+    if (batch_size == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Context::resize",
+            "Cannot resize an inference context to a batch size of 0");
+        exit(EXIT_FAILURE);
+    }
+
+    if (batch_size == m_batch_size) { return false; }
+
+    m_batch_size = batch_size;
+
+    if (batch_size > m_max_batch_size) {
+        allocate(batch_size);
+        return true;
+    }
+
+    bind_views();
+    return false;
+}
+
+Matrix& Inference_Context::activations(size_t layer) {
+
+    if (layer == 0 || layer >= m_layer_info.size()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Context::activations",
+            std::format("Layer {} has no activations in this context", layer));
+        exit(EXIT_FAILURE);
+    }
+
+    return *(m_views[layer]);
+}
+
+Matrix& Inference_Context::inputs(void) {
+
+    return *(m_views[0]);
+}
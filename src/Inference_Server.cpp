@@ -0,0 +1,474 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Inference_Server.hpp"
+
+using Inference_Server_NS::Inference_Server;
+using Inference_Server_NS::Inference_Connection;
+
+Inference_Server::Inference_Server(const Neural_Network& network, const char* socket_path,
+    size_t max_batch_size, size_t max_wait_us) : m_network(network) {
+
+    if (max_batch_size == 0 || network.get_num_layers() < 2) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::Inference_Server",
+            "The server needs a trained network and a non-zero max batch size");
+        exit(EXIT_FAILURE);
+    }
+
+    m_socket_path = socket_path;
+    m_max_batch_size = max_batch_size;
+    m_max_wait_us = max_wait_us;
+    m_input_size = network.get_num_neurons(0);
+    m_output_size = network.get_num_neurons(network.get_num_layers() - 1);
+
+    // Everything a batch touches is allocated once, for the largest batch
+    m_staging = (uint8_t*)calloc(m_max_batch_size * m_input_size, sizeof(uint8_t));
+    m_batch_data = (uint8_t*)calloc(m_max_batch_size * m_input_size, sizeof(uint8_t));
+    m_results_data = (float*)calloc(m_max_batch_size * m_output_size, sizeof(float));
+    m_batch_owners = (Inference_Connection**)calloc(m_max_batch_size, sizeof(Inference_Connection*));
+
+    if (m_staging == NULL || m_batch_data == NULL || m_results_data == NULL || m_batch_owners == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::Inference_Server",
+            "Unable to allocate memory for the batch buffers");
+        exit(EXIT_FAILURE);
+    }
+
+    m_batch = new Byte_Matrix(0, 0, NULL);
+    m_results = new Matrix(0, 0, NULL);
+    m_context = network.create_inference_context(m_max_batch_size);
+
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    m_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_epoll_fd < 0 || m_timer_fd < 0 || m_wake_fd < 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::Inference_Server",
+            std::format("Unable to create the event loop: {}", strerror(errno)));
+        exit(EXIT_FAILURE);
+    }
+
+    open_socket();
+
+    // The listening socket, timer and wake-up eventfd are told apart by the address of their member
+    watch(m_listen_fd, EPOLLIN, &m_listen_fd);
+    watch(m_timer_fd, EPOLLIN, &m_timer_fd);
+    watch(m_wake_fd, EPOLLIN, &m_wake_fd);
+}
+
+Inference_Server::~Inference_Server() {
+
+    for (auto& entry : m_connections) {
+        close(entry.second->fd);
+        free(entry.second->input);
+        delete entry.second;
+    }
+    m_connections.clear();
+
+    for (Inference_Connection* connection : m_closed) {
+        free(connection->input);
+        delete connection;
+    }
+    m_closed.clear();
+
+    if (m_listen_fd >= 0) {
+        close(m_listen_fd);
+        unlink(m_socket_path.c_str());
+    }
+    if (m_epoll_fd >= 0) { close(m_epoll_fd); }
+    if (m_timer_fd >= 0) { close(m_timer_fd); }
+    if (m_wake_fd >= 0) { close(m_wake_fd); }
+
+    if (m_context != NULL) { delete m_context; }
+    if (m_batch != NULL) { delete m_batch; }
+    if (m_results != NULL) { delete m_results; }
+
+    free(m_staging);
+    free(m_batch_data);
+    free(m_results_data);
+    free(m_batch_owners);
+}
+
+void Inference_Server::open_socket(void) {
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (m_socket_path.size() >= sizeof(address.sun_path)) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::open_socket",
+            std::format("Socket path '{}' is too long", m_socket_path));
+        exit(EXIT_FAILURE);
+    }
+    memcpy(address.sun_path, m_socket_path.c_str(), m_socket_path.size());
+
+    // A socket file left behind by a previous run would make bind fail. Anything else at the
+    // path is left alone
+    struct stat existing;
+    if (lstat(m_socket_path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+        unlink(m_socket_path.c_str());
+    }
+
+    m_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (m_listen_fd < 0 || bind(m_listen_fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(m_listen_fd, INFERENCE_SERVER_LISTEN_BACKLOG) != 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::open_socket",
+            std::format("Unable to listen on '{}': {}", m_socket_path, strerror(errno)));
+        exit(EXIT_FAILURE);
+    }
+}
+
+void Inference_Server::watch(int fd, uint32_t events, void* data) {
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.ptr = data;
+
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::watch",
+            std::format("Unable to watch file descriptor {}: {}", fd, strerror(errno)));
+        exit(EXIT_FAILURE);
+    }
+}
+
+void Inference_Server::accept_connections(void) {
+
+    while (true) {
+        int fd = accept4(m_listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                Log::log_message(Log::Log_Priority::WARNING, "Inference_Server::accept_connections",
+                    std::format("Unable to accept a connection: {}", strerror(errno)));
+            }
+            return;
+        }
+
+        Inference_Connection* connection = new Inference_Connection();
+        connection->fd = fd;
+        connection->input = (uint8_t*)malloc(m_input_size * INFERENCE_SERVER_READ_REQUESTS);
+
+        if (connection->input == NULL) {
+            Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::accept_connections",
+                "Unable to allocate memory for a connection");
+            exit(EXIT_FAILURE);
+        }
+
+        m_connections[fd] = connection;
+        connection->events = EPOLLIN | EPOLLRDHUP;
+        watch(fd, connection->events, connection);
+    }
+}
+
+void Inference_Server::read_connection(Inference_Connection& connection) {
+
+    const size_t capacity = m_input_size * INFERENCE_SERVER_READ_REQUESTS;
+    ssize_t bytes = recv(connection.fd, connection.input + connection.received, capacity - connection.received, 0);
+
+    if (bytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        close_connection(connection);
+        return;
+    }
+
+    // A client that has finished sending may still be waiting on responses, so stop reading
+    // but keep the connection until everything it asked for has been sent
+    if (bytes == 0) {
+        connection.read_closed = true;
+        if (connection.pending == 0 && connection.output.empty()) {
+            close_connection(connection);
+        }
+        else {
+            update_events(connection);
+        }
+        return;
+    }
+    if (bytes < 0) { return; }
+
+    connection.received += (size_t)bytes;
+
+    // Queue every complete request, keeping any partial one at the front for the next read
+    size_t consumed = 0;
+    while (connection.received - consumed >= m_input_size) {
+        queue_request(connection, connection.input + consumed);
+        consumed += m_input_size;
+    }
+
+    if (consumed != 0) {
+        memmove(connection.input, connection.input + consumed, connection.received - consumed);
+        connection.received -= consumed;
+    }
+
+    // Stop reading a client that isn't keeping up with its responses. flush_connection starts
+    // reading again once they drain
+    if (!connection.closed && backlogged(connection)) {
+        update_events(connection);
+    }
+}
+
+void Inference_Server::queue_request(Inference_Connection& connection, const uint8_t* request) {
+
+    // The first request of a batch starts the clock on how long the batch may wait
+    if (m_batch_count == 0) {
+        arm_timer(m_max_wait_us);
+    }
+
+    memcpy(m_staging + (m_batch_count * m_input_size), request, m_input_size);
+    m_batch_owners[m_batch_count] = &connection;
+    ++m_batch_count;
+    ++connection.pending;
+
+    if (m_batch_count == m_max_batch_size) {
+        run_batch();
+    }
+}
+
+void Inference_Server::run_batch(void) {
+
+    const size_t columns = m_batch_count;
+    if (columns == 0) { return; }
+
+    disarm_timer();
+
+    // Requests arrive one per row; inference wants one per column
+    for (size_t i = 0; i < columns; ++i) {
+        const uint8_t* request = m_staging + (i * m_input_size);
+        for (size_t j = 0; j < m_input_size; ++j) {
+            m_batch_data[(j * columns) + i] = request[j];
+        }
+    }
+
+    m_batch->rebind(m_input_size, columns, m_batch_data);
+    m_results->rebind(m_output_size, columns, m_results_data);
+    m_network.inference(*m_batch, *m_results, *m_context);
+
+    // Append each column of results to its connection's output, in request order
+    for (size_t i = 0; i < columns; ++i) {
+        Inference_Connection& connection = *(m_batch_owners[i]);
+        --connection.pending;
+
+        if (connection.closed) { continue; }
+
+        const size_t offset = connection.output.size();
+        connection.output.resize(offset + (m_output_size * sizeof(float)));
+        float* response = (float*)(connection.output.data() + offset);
+
+        for (size_t j = 0; j < m_output_size; ++j) {
+            response[j] = m_results_data[(j * columns) + i];
+        }
+
+        if (!connection.needs_flush) {
+            connection.needs_flush = true;
+            m_flush.push_back(&connection);
+        }
+    }
+
+    m_batch_count = 0;
+    m_requests_served += columns;
+    ++m_batches_run;
+
+    // One send per connection per batch, however many of its requests were in it
+    for (Inference_Connection* connection : m_flush) {
+        connection->needs_flush = false;
+        if (!connection->closed) { flush_connection(*connection); }
+    }
+    m_flush.clear();
+}
+
+void Inference_Server::flush_connection(Inference_Connection& connection) {
+
+    size_t sent = 0;
+
+    while (sent < connection.output.size()) {
+        ssize_t bytes = send(connection.fd, connection.output.data() + sent, connection.output.size() - sent,
+            MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (bytes < 0) {
+            if (errno == EINTR) { continue; }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) { break; }
+            close_connection(connection);
+            return;
+        }
+        sent += (size_t)bytes;
+    }
+
+    connection.output.erase(connection.output.begin(), connection.output.begin() + sent);
+
+    if (connection.read_closed && connection.pending == 0 && connection.output.empty()) {
+        close_connection(connection);
+        return;
+    }
+
+    update_events(connection);
+}
+
+bool Inference_Server::backlogged(const Inference_Connection& connection) const {
+
+    // Requests still in the batch count too, since each will become a response
+    const size_t response_bytes = m_output_size * sizeof(float);
+    return connection.output.size() + (connection.pending * response_bytes) >= INFERENCE_SERVER_MAX_PENDING_OUTPUT;
+}
+
+void Inference_Server::update_events(Inference_Connection& connection) {
+
+    // Only wait for the socket to drain while there is something left to send, and only read
+    // while the client isn't too far behind
+    uint32_t events = 0;
+    if (!connection.read_closed && !backlogged(connection)) { events |= EPOLLIN | EPOLLRDHUP; }
+    if (!connection.output.empty()) { events |= EPOLLOUT; }
+
+    if (events == connection.events) { return; }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.ptr = &connection;
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.events = events;
+}
+
+void Inference_Server::close_connection(Inference_Connection& connection) {
+
+    if (connection.closed) { return; }
+
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, connection.fd, NULL);
+    close(connection.fd);
+    m_connections.erase(connection.fd);
+
+    connection.closed = true;
+    connection.fd = -1;
+    m_closed.push_back(&connection);
+}
+
+void Inference_Server::release_connections(void) {
+
+    size_t kept = 0;
+
+    for (size_t i = 0; i < m_closed.size(); ++i) {
+        if (m_closed[i]->pending == 0) {
+            free(m_closed[i]->input);
+            delete m_closed[i];
+        }
+        else {
+            m_closed[kept++] = m_closed[i];
+        }
+    }
+
+    m_closed.resize(kept);
+}
+
+void Inference_Server::arm_timer(size_t microseconds) {
+
+    struct itimerspec deadline;
+    memset(&deadline, 0, sizeof(deadline));
+    deadline.it_value.tv_sec = microseconds / 1000000;
+    deadline.it_value.tv_nsec = (microseconds % 1000000) * 1000;
+
+    // A zero it_value would disarm the timer instead
+    if (microseconds == 0) {
+        deadline.it_value.tv_nsec = 1;
+    }
+
+    timerfd_settime(m_timer_fd, 0, &deadline, NULL);
+}
+
+void Inference_Server::disarm_timer(void) {
+
+    struct itimerspec deadline;
+    memset(&deadline, 0, sizeof(deadline));
+    timerfd_settime(m_timer_fd, 0, &deadline, NULL);
+}
+
+void Inference_Server::run(void) {
+
+    struct epoll_event events[INFERENCE_SERVER_MAX_EVENTS];
+    m_running = true;
+
+    if (INFERENCE_SERVER_DEBUG) {
+        Log::log_message(Log::Log_Priority::INFO, "Inference_Server::run",
+            std::format("Serving on '{}' with batches of up to {} and a {} us deadline",
+                m_socket_path, m_max_batch_size, m_max_wait_us));
+    }
+
+    while (m_running) {
+        int ready = epoll_wait(m_epoll_fd, events, INFERENCE_SERVER_MAX_EVENTS, -1);
+
+        if (ready < 0) {
+            if (errno == EINTR) { continue; }
+            Log::log_message(Log::Log_Priority::ERROR, "Inference_Server::run",
+                std::format("epoll_wait failed: {}", strerror(errno)));
+            exit(EXIT_FAILURE);
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            void* source = events[i].data.ptr;
+
+            if (source == &m_listen_fd) {
+                accept_connections();
+            }
+            else if (source == &m_timer_fd) {
+                uint64_t expirations = 0;
+                if (read(m_timer_fd, &expirations, sizeof(expirations)) > 0) { run_batch(); }
+            }
+            else if (source == &m_wake_fd) {
+                m_running = false;
+            }
+            else {
+                // Connections closed earlier in this round stay allocated until release_connections
+                Inference_Connection& connection = *(Inference_Connection*)source;
+
+                if (!connection.closed && (events[i].events & EPOLLOUT)) {
+                    flush_connection(connection);
+                }
+                if (connection.closed) { continue; }
+
+                // Once reading has stopped only a hangup or error can be reported, and either
+                // means the client is gone for good
+                if (connection.read_closed && (events[i].events & (EPOLLHUP | EPOLLERR))) {
+                    close_connection(connection);
+                }
+                else if (!connection.read_closed && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                    read_connection(connection);
+                }
+            }
+        }
+
+        release_connections();
+    }
+
+    // Answer anything already queued before returning
+    run_batch();
+    release_connections();
+}
+
+void Inference_Server::stop(void) {
+
+    // write() is async-signal-safe, so this works from a signal handler
+    uint64_t value = 1;
+    ssize_t written = write(m_wake_fd, &value, sizeof(value));
+    (void)written;
+}
+
+size_t Inference_Server::requests_served(void) const {
+
+    return m_requests_served;
+}
+
+size_t Inference_Server::batches_run(void) const {
+
+    return m_batches_run;
+}
@@ -0,0 +1,432 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/MNIST_Stream.hpp"
+
+using MNIST_Stream_NS::MNIST_Stream;
+
+int MNIST_Stream::open_idx(const char* path, uint32_t magic, uint32_t* dimensions, size_t* offset) {
+
+    int file = open(path, O_RDONLY);
+    if (file < 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::open_idx",
+            std::format("Unable to open path '{}'. Exiting...", path));
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t num_dimensions = magic & 0xFF;
+    uint32_t header[IDX_FILE_MAX_DIMENSIONS + 1];
+
+    if (num_dimensions == 0 || num_dimensions > IDX_FILE_MAX_DIMENSIONS) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::open_idx",
+            std::format("Unsupported number of dimensions {}", num_dimensions));
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t header_size = (num_dimensions + 1) * sizeof(uint32_t);
+    if (pread(file, header, header_size, 0) != (ssize_t)header_size) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::open_idx",
+            std::format("Unable to read headers from '{}'", path));
+        close(file);
+        exit(EXIT_FAILURE);
+    }
+
+    if (MNIST_Utils_NS::map_uint32(header[0]) != magic) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::open_idx",
+            std::format("Mismatched magic number in the header of '{}'", path));
+        close(file);
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < num_dimensions; ++i) {
+        dimensions[i] = MNIST_Utils_NS::map_uint32(header[i + 1]);
+    }
+    *offset = header_size;
+
+    return file;
+}
+
+MNIST_Stream::MNIST_Stream(const char* images_path, const char* labels_path, size_t chunk_images,
+    size_t num_buffers) {
+
+    if (chunk_images == 0 || num_buffers == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::MNIST_Stream",
+            std::format("Invalid setup: {} images per chunk, {} buffers", chunk_images, num_buffers));
+        exit(EXIT_FAILURE);
+    }
+
+    uint32_t image_dimensions[3] = {0, 0, 0};
+    uint32_t label_dimensions[1] = {0};
+
+    m_images_file = open_idx(images_path, MNIST_IMAGE_MAGIC, image_dimensions, &m_images_offset);
+    m_labels_file = open_idx(labels_path, MNIST_LABEL_MAGIC, label_dimensions, &m_labels_offset);
+
+    if (image_dimensions[1] != MNIST_IMAGE_HEIGHT || image_dimensions[2] != MNIST_IMAGE_WIDTH) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::MNIST_Stream",
+            std::format("Unexpected image dimensions provided. Detected [{} x {}] but expected [{} x {}]",
+                image_dimensions[1], image_dimensions[2], MNIST_IMAGE_HEIGHT, MNIST_IMAGE_WIDTH));
+        exit(EXIT_FAILURE);
+    }
+    if (image_dimensions[0] != label_dimensions[0]) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::MNIST_Stream",
+            std::format("'{}' has {} images but '{}' has {} labels", images_path, image_dimensions[0],
+                labels_path, label_dimensions[0]));
+        exit(EXIT_FAILURE);
+    }
+
+    m_num_images = image_dimensions[0];
+    m_chunk_images = chunk_images;
+    m_num_chunks = (m_num_images + chunk_images - 1) / chunk_images;
+    // No point holding more buffers than there are chunks
+    m_num_buffers = (num_buffers < m_num_chunks) ? num_buffers : m_num_chunks;
+    if (m_num_buffers == 0) { m_num_buffers = 1; }
+
+    m_pixels = (uint8_t*)malloc(m_num_buffers * chunk_images * MNIST_IMAGE_SIZE);
+    m_labels = (uint8_t*)malloc(m_num_buffers * chunk_images);
+    m_buffer_chunk = (size_t*)calloc(m_num_buffers, sizeof(size_t));
+    m_buffer_used = (size_t*)calloc(m_num_buffers, sizeof(size_t));
+    m_chunk_buffer = (size_t*)calloc(m_num_chunks + 1, sizeof(size_t));
+    m_chunk_order = (size_t*)calloc(m_num_chunks + 1, sizeof(size_t));
+    m_window = (size_t*)calloc(m_num_buffers * chunk_images, sizeof(size_t));
+
+    if (m_pixels == NULL || m_labels == NULL || m_buffer_chunk == NULL || m_buffer_used == NULL ||
+        m_chunk_buffer == NULL || m_chunk_order == NULL || m_window == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::MNIST_Stream",
+            "Unable to allocate memory for the buffer pool");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < m_num_buffers; ++i) {
+        m_buffer_chunk[i] = MNIST_STREAM_NOT_LOADED;
+    }
+    for (size_t i = 0; i < m_num_chunks; ++i) {
+        m_chunk_buffer[i] = MNIST_STREAM_NOT_LOADED;
+        m_chunk_order[i] = i;
+    }
+
+    // Chunks are visited in a shuffled order, so readahead of whatever follows on disk is wasted.
+    // next_window asks for the chunks it needs next with POSIX_FADV_WILLNEED instead
+    posix_fadvise(m_images_file, 0, 0, POSIX_FADV_RANDOM);
+
+    if (MNIST_UTILS_DEBUG) {
+        Log::log_message(Log::Log_Priority::INFO, "MNIST_Stream::MNIST_Stream",
+            std::format("Streaming {} images in {} chunks through {} bytes of buffers",
+                m_num_images, m_num_chunks, pool_bytes()));
+    }
+}
+
+MNIST_Stream::~MNIST_Stream() {
+
+    if (m_images_file >= 0) { close(m_images_file); }
+    if (m_labels_file >= 0) { close(m_labels_file); }
+
+    free(m_pixels);
+    free(m_labels);
+    free(m_buffer_chunk);
+    free(m_buffer_used);
+    free(m_chunk_buffer);
+    free(m_chunk_order);
+    free(m_window);
+    free(m_batch_pixels);
+}
+
+size_t MNIST_Stream::size(void) const {
+    return m_num_images;
+}
+
+size_t MNIST_Stream::pool_bytes(void) const {
+    return m_num_buffers * m_chunk_images * (MNIST_IMAGE_SIZE + 1);
+}
+
+size_t MNIST_Stream::chunk_size(size_t chunk) const {
+
+    const size_t start = chunk * m_chunk_images;
+    return (m_num_images - start < m_chunk_images) ? m_num_images - start : m_chunk_images;
+}
+
+size_t MNIST_Stream::load(size_t chunk) {
+
+    size_t buffer = m_chunk_buffer[chunk];
+
+    if (buffer == MNIST_STREAM_NOT_LOADED) {
+        // Evict the least recently used buffer
+        buffer = 0;
+        for (size_t i = 1; i < m_num_buffers; ++i) {
+            if (m_buffer_used[i] < m_buffer_used[buffer]) { buffer = i; }
+        }
+        if (m_buffer_chunk[buffer] != MNIST_STREAM_NOT_LOADED) {
+            m_chunk_buffer[m_buffer_chunk[buffer]] = MNIST_STREAM_NOT_LOADED;
+        }
+
+        const size_t images = chunk_size(chunk);
+        const size_t first = chunk * m_chunk_images;
+        uint8_t* pixels = m_pixels + (buffer * m_chunk_images * MNIST_IMAGE_SIZE);
+        uint8_t* labels = m_labels + (buffer * m_chunk_images);
+
+        // pread can return short, keep going until the whole chunk is in
+        size_t done = 0;
+        while (done < images * MNIST_IMAGE_SIZE) {
+            ssize_t result = pread(m_images_file, pixels + done, (images * MNIST_IMAGE_SIZE) - done,
+                m_images_offset + (first * MNIST_IMAGE_SIZE) + done);
+            if (result <= 0) {
+                Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::load",
+                    std::format("Failed to read images for chunk {}", chunk));
+                exit(EXIT_FAILURE);
+            }
+            done += (size_t)result;
+        }
+        if (pread(m_labels_file, labels, images, m_labels_offset + first) != (ssize_t)images) {
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::load",
+                std::format("Failed to read labels for chunk {}", chunk));
+            exit(EXIT_FAILURE);
+        }
+
+        // The pool has its own copy now, so don't let the page cache keep a second one
+        posix_fadvise(m_images_file, m_images_offset + (first * MNIST_IMAGE_SIZE), images * MNIST_IMAGE_SIZE,
+            POSIX_FADV_DONTNEED);
+
+        m_buffer_chunk[buffer] = chunk;
+        m_chunk_buffer[chunk] = buffer;
+    }
+
+    m_buffer_used[buffer] = ++m_clock;
+    return buffer;
+}
+
+const uint8_t* MNIST_Stream::pixels(size_t index) {
+
+    if (index >= m_num_images) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::pixels",
+            std::format("Index {} requested, but the stream ends at index {}", index, m_num_images - 1));
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t buffer = load(index / m_chunk_images);
+    return m_pixels + (((buffer * m_chunk_images) + (index % m_chunk_images)) * MNIST_IMAGE_SIZE);
+}
+
+void MNIST_Stream::reserve_batch(size_t elements) {
+
+    if (elements <= m_batch_capacity) { return; }
+
+    free(m_batch_pixels);
+    m_batch_pixels = (const uint8_t**)calloc(elements, sizeof(uint8_t*));
+    if (m_batch_pixels == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::reserve_batch",
+            "Unable to allocate memory for the batch");
+        exit(EXIT_FAILURE);
+    }
+    m_batch_capacity = elements;
+}
+
+void MNIST_Stream::write_columns(size_t count, size_t first_column, Matrix& destination) const {
+
+    const size_t columns = destination.cols();
+    float* target = destination.data() + first_column;
+
+    // Read the images side by side so each destination row is written contiguously. Dividing
+    // keeps the results identical to pixel_to_float
+    for (size_t k = 0; k < MNIST_IMAGE_SIZE; ++k) {
+        float* row = target + (k * columns);
+        for (size_t j = 0; j < count; ++j) {
+            row[j] = (float)m_batch_pixels[j][k] / 255.0f;
+        }
+    }
+}
+
+void MNIST_Stream::get_flat(size_t index, Matrix& destination) {
+
+    if (destination.rows() * destination.cols() != MNIST_IMAGE_SIZE) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::get_flat",
+            "Incorrect destination Matrix size");
+        exit(EXIT_FAILURE);
+    }
+
+    destination.flatten(Matrix_NS::Vector_Orientation::COLUMN);
+    Matrix_Kernels_NS::kernels().convert_u8(pixels(index), 255.0f, destination.data(), MNIST_IMAGE_SIZE);
+}
+
+void MNIST_Stream::create_images_from_range(size_t image_start, size_t image_end, Matrix& destination) {
+
+    if (image_start >= image_end || image_end > m_num_images) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::create_images_from_range",
+            std::format("Got range ({}, {}), but the stream ends at index {}", image_start, image_end,
+                m_num_images - 1));
+        exit(EXIT_FAILURE);
+    }
+    if (destination.rows() != MNIST_IMAGE_SIZE || destination.cols() != image_end - image_start) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::create_images_from_range",
+            "Destination Matrix size incorrect");
+        exit(EXIT_FAILURE);
+    }
+
+    // Work a chunk at a time, since loading one chunk may evict the previous one
+    size_t column = 0;
+    reserve_batch(m_chunk_images);
+
+    for (size_t i = image_start; i < image_end;) {
+        const size_t chunk_end = ((i / m_chunk_images) + 1) * m_chunk_images;
+        const size_t count = ((chunk_end < image_end) ? chunk_end : image_end) - i;
+
+        const uint8_t* first = pixels(i);
+        for (size_t j = 0; j < count; ++j) {
+            m_batch_pixels[j] = first + (j * MNIST_IMAGE_SIZE);
+        }
+        write_columns(count, column, destination);
+
+        column += count;
+        i += count;
+    }
+}
+
+uint8_t MNIST_Stream::get_label(size_t index) {
+
+    if (index >= m_num_images) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::get_label",
+            std::format("Index {} requested, but the stream ends at index {}", index, m_num_images - 1));
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t buffer = load(index / m_chunk_images);
+    return m_labels[(buffer * m_chunk_images) + (index % m_chunk_images)];
+}
+
+void MNIST_Stream::create_label(size_t index, Matrix& destination) {
+
+    destination.populate(0);
+    destination.set(get_label(index), 0, 1);
+}
+
+void MNIST_Stream::create_labels_from_range(size_t label_start, size_t label_end, Matrix& destination) {
+
+    if (label_start >= label_end || label_end > m_num_images || destination.cols() != label_end - label_start) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::create_labels_from_range",
+            "Invalid range or destination size provided");
+        exit(EXIT_FAILURE);
+    }
+
+    destination.populate(0);
+    for (size_t i = label_start; i < label_end; ++i) {
+        destination.set(get_label(i), i - label_start, 1);
+    }
+}
+
+void MNIST_Stream::begin_epoch(void) {
+
+    // Shuffle the order the chunks are visited in. An empty dataset has no chunks, and
+    // m_num_chunks - 1 would wrap
+    for (size_t i = m_num_chunks - 1; m_num_chunks > 1 && i > 0; --i) {
+        size_t random_index = rand() % (i + 1);
+        size_t current_value = m_chunk_order[i];
+        m_chunk_order[i] = m_chunk_order[random_index];
+        m_chunk_order[random_index] = current_value;
+    }
+
+    m_next_chunk = 0;
+    m_window_size = 0;
+    m_window_position = 0;
+}
+
+bool MNIST_Stream::next_window(void) {
+
+    if (m_next_chunk >= m_num_chunks) { return false; }
+
+    const size_t window_end = (m_next_chunk + m_num_buffers < m_num_chunks) ?
+        m_next_chunk + m_num_buffers : m_num_chunks;
+
+    m_window_size = 0;
+    for (size_t i = m_next_chunk; i < window_end; ++i) {
+        const size_t chunk = m_chunk_order[i];
+        load(chunk);
+        for (size_t j = 0; j < chunk_size(chunk); ++j) {
+            m_window[m_window_size++] = (chunk * m_chunk_images) + j;
+        }
+    }
+    m_next_chunk = window_end;
+    m_window_position = 0;
+
+    // Shuffle the images across the whole window
+    for (size_t i = m_window_size - 1; i > 0; --i) {
+        size_t random_index = rand() % (i + 1);
+        size_t current_value = m_window[i];
+        m_window[i] = m_window[random_index];
+        m_window[random_index] = current_value;
+    }
+
+    // Have the kernel start reading the next window while this one is used
+    const size_t prefetch_end = (m_next_chunk + m_num_buffers < m_num_chunks) ?
+        m_next_chunk + m_num_buffers : m_num_chunks;
+    for (size_t i = m_next_chunk; i < prefetch_end; ++i) {
+        const size_t chunk = m_chunk_order[i];
+        posix_fadvise(m_images_file, m_images_offset + (chunk * m_chunk_images * MNIST_IMAGE_SIZE),
+            chunk_size(chunk) * MNIST_IMAGE_SIZE, POSIX_FADV_WILLNEED);
+    }
+
+    return true;
+}
+
+bool MNIST_Stream::next_batch(Matrix& images, Matrix& labels) {
+
+    const size_t batch_size = images.cols();
+
+    if (images.rows() != MNIST_IMAGE_SIZE || labels.rows() != MNIST_LABELS || labels.cols() != batch_size) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Stream::next_batch",
+            "Images and labels Matrix sizes do not match");
+        exit(EXIT_FAILURE);
+    }
+
+    reserve_batch(batch_size);
+    labels.populate(0);
+
+    size_t filled = 0;
+    while (filled < batch_size) {
+        if (m_window_position >= m_window_size && !next_window()) {
+            // A partial batch at the end of the epoch is dropped, same as batch_train_new_model
+            return false;
+        }
+
+        // Take what this window has left. Random access since next_window may have evicted some
+        // of its chunks, so each image goes through load(), which re-reads a missing chunk
+        const size_t available = m_window_size - m_window_position;
+        const size_t count = (batch_size - filled < available) ? batch_size - filled : available;
+        size_t gathered = 0;
+
+        for (size_t j = 0; j < count; ++j) {
+            const size_t index = m_window[m_window_position + j];
+            const size_t chunk = index / m_chunk_images;
+
+            // Reloading a chunk can evict the buffer of an image already gathered, so write
+            // those columns out first
+            if (m_chunk_buffer[chunk] == MNIST_STREAM_NOT_LOADED && gathered != 0) {
+                write_columns(gathered, filled + j - gathered, images);
+                gathered = 0;
+            }
+
+            const size_t buffer = load(chunk);
+            const size_t offset = (buffer * m_chunk_images) + (index % m_chunk_images);
+
+            m_batch_pixels[gathered++] = m_pixels + (offset * MNIST_IMAGE_SIZE);
+            labels.set(m_labels[offset], filled + j, 1);
+        }
+        write_columns(gathered, filled + count - gathered, images);
+
+        m_window_position += count;
+        filled += count;
+    }
+
+    return true;
+}
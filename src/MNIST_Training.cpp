@@ -8,7 +8,7 @@
  *                                                                                                               
  * Project: Basic Neural Network in C++
  * @author : Samuel Andersen
- * @version: 2025-07-22
+ * @version: 2026-10-17
  *
  * General Notes:
  *
@@ -21,12 +21,50 @@ using Matrix = Matrix_NS::Matrix<float>;
 using Neural_Network = Neural_Network_NS::Neural_Network;
 using MNIST_Images = MNIST_Utils_NS::MNIST_Images;
 using MNIST_Labels = MNIST_Utils_NS::MNIST_Labels;
+using MNIST_Stream = MNIST_Stream_NS::MNIST_Stream;
+using Neural_Network_Workspace = Neural_Network_Workspace_NS::Neural_Network_Workspace;
+using Batch_Pipeline = Batch_Pipeline_NS::Batch_Pipeline;
+using Batch_Pipeline_Slot = Batch_Pipeline_NS::Batch_Pipeline_Slot;
+using Inference_Context = Inference_Context_NS::Inference_Context;
+using Thread_Pool = Thread_Pool_NS::Thread_Pool;
+
+/* Scratch space and the running count for one threaded_predict thread, kept on its own lines */
+struct alignas(64) Predict_Worker {
+    Inference_Context* context = NULL;
+    uint8_t* pixels = NULL;
+    float* inputs = NULL;
+    float* results = NULL;
+    Byte_Matrix* pixel_view = NULL;
+    Matrix* input_view = NULL;
+    Matrix* result_view = NULL;
+    size_t correct = 0;
+};
+
+/**
+ * Find the row holding the largest value in a column, without copying the column out
+ * @param target The Matrix to search
+ * @param col The column to search
+ * @returns Returns the row index of the largest value
+ */
+static size_t column_argmax(const Matrix& target, size_t col) {
+
+    const float* data = target.data();
+    const size_t cols = target.cols();
+    size_t max_index = 0;
+
+    for (size_t i = 1; i < target.rows(); ++i) {
+        if (data[(i * cols) + col] > data[(max_index * cols) + col]) { max_index = i; }
+    }
+
+    return max_index;
+}
 
 void MNIST_Training_NS::train_new_model(const char* labels_path, const char* images_path, 
     const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t num_training_images, 
-    size_t epochs, Neural_Network_NS::Cost_Function cost_function, const char* model_path) {
+    size_t epochs, Neural_Network_NS::Cost_Function cost_function, const char* model_path,
+    MNIST_Utils_NS::Pixel_Format pixel_format) {
 
-    MNIST_Images images = MNIST_Images(images_path);
+    MNIST_Images images = MNIST_Images(images_path, pixel_format);
     MNIST_Labels labels = MNIST_Labels(labels_path);
 
     if (layer_info.size() == 0) {
@@ -38,26 +76,30 @@ void MNIST_Training_NS::train_new_model(const char* labels_path, const char* ima
     // Instantiate the Neural Network
     Neural_Network nn = Neural_Network(layer_info, learning_rate, lambda, cost_function);
 
-    // Setup Matrix instances that will be reused for processing images and labels
-    Matrix current_image = Matrix(MNIST_IMAGE_SIZE, 1);
-    Matrix current_label = Matrix(MNIST_LABELS, 1);
+    // Loader threads build each image and label ahead of the trainer, in a shuffled order per epoch
+    size_t* schedule = create_schedule(images.size(), num_training_images, epochs);
+    Batch_Pipeline pipeline = Batch_Pipeline(images, labels, 1, schedule, num_training_images * epochs,
+        MNIST_TRAINING_LOADER_THREADS, MNIST_TRAINING_PIPELINE_SLOTS);
+    free(schedule);
 
-    // Setup a shuffled array index
-    size_t* shuffled_index = NULL;
     // Track the loss
     float loss = 0;
 
-    for (size_t i = 0; i < epochs; ++i) {
+    auto start_time = std::chrono::steady_clock::now();
 
-        // Create a shuffled index array
-        shuffled_index = create_index_array(images.size());
+    for (size_t i = 0; i < epochs; ++i) {
 
         // Iterate through the number of images per epoch
         for (size_t j = 0; j < num_training_images; ++j) {
-            
-            images.get_flat(shuffled_index[i], current_image);
-            labels.create_label(shuffled_index[i], current_label);
-            loss = nn.train(current_image, current_label, num_training_images);
+
+            const Batch_Pipeline_Slot& current = pipeline.acquire();
+            if (current.raw_images != NULL) {
+                loss = nn.batch_train(*(current.raw_images), *(current.labels), num_training_images);
+            }
+            else {
+                loss = nn.train(*(current.images), *(current.labels), num_training_images);
+            }
+            pipeline.release();
 
             if (MNIST_TRAINING_SHOW_LOSS) {
                 if (j % MNIST_TRAINING_SHOW_LOSS_STEPS == 0) {
@@ -66,11 +108,469 @@ void MNIST_Training_NS::train_new_model(const char* labels_path, const char* ima
                 }
             }
         }
+    }
+
+    Log::log_message(Log::Log_Priority::INFO, "train_new_model",
+        std::format("Waited on the loaders for {} of {} images", pipeline.stalls(), num_training_images * epochs));
+
+    report_training("train_new_model", nn, images, labels, num_training_images * epochs,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+
+    nn.save(model_path);
+}
+
+void MNIST_Training_NS::hogwild_train_new_model(const char* labels_path, const char* images_path, 
+    const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t num_training_images, 
+    size_t epochs, Neural_Network_NS::Cost_Function cost_function, size_t num_threads, const char* model_path) {
+
+    MNIST_Images images = MNIST_Images(images_path);
+    MNIST_Labels labels = MNIST_Labels(labels_path);
+
+    if (layer_info.size() == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "hogwild_train_new_model",
+            "Invalid layer_info vector provided");
+        return;
+    }
+
+    if (num_threads == 0 || num_training_images > images.size()) {
+        Log::log_message(Log::Log_Priority::ERROR, "hogwild_train_new_model",
+            std::format("Invalid setup: {} images with {} threads", num_training_images, num_threads));
+        return;
+    }
+
+    // Instantiate the Neural Network, shared by every thread
+    Neural_Network nn = Neural_Network(layer_info, learning_rate, lambda, cost_function);
+
+    // Each thread gets its own image, label and workspace so the only thing shared is the weights
+    Matrix** current_images = (Matrix**)calloc(num_threads, sizeof(Matrix*));
+    Matrix** current_labels = (Matrix**)calloc(num_threads, sizeof(Matrix*));
+    Neural_Network_Workspace** workspaces = (Neural_Network_Workspace**)calloc(num_threads,
+        sizeof(Neural_Network_Workspace*));
+
+    if (current_images == NULL || current_labels == NULL || workspaces == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "hogwild_train_new_model",
+            "Unable to allocate memory for the per-thread state");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        current_images[i] = new Matrix(MNIST_IMAGE_SIZE, 1);
+        current_labels[i] = new Matrix(MNIST_LABELS, 1);
+        workspaces[i] = nn.create_workspace(1);
+    }
+
+    Thread_Pool_NS::Thread_Pool pool = Thread_Pool_NS::Thread_Pool(num_threads);
+
+    // Setup a shuffled array index
+    size_t* shuffled_index = NULL;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < epochs; ++i) {
+
+        // One shuffle per epoch, then each thread walks its own contiguous slice of it
+        shuffled_index = create_index_array(images.size());
+
+        auto train_slice = [&](size_t thread) {
+            const size_t slice_start = (thread * num_training_images) / num_threads;
+            const size_t slice_end = ((thread + 1) * num_training_images) / num_threads;
+            float loss = 0;
+
+            for (size_t j = slice_start; j < slice_end; ++j) {
+                images.get_flat(shuffled_index[j], *(current_images[thread]));
+                labels.create_label(shuffled_index[j], *(current_labels[thread]));
+                loss = nn.hogwild_train(*(current_images[thread]), *(current_labels[thread]),
+                    num_training_images, *(workspaces[thread]));
+
+                // Only the first thread logs so the output stays readable
+                if (MNIST_TRAINING_SHOW_LOSS && thread == 0) {
+                    if ((j - slice_start) % MNIST_TRAINING_SHOW_LOSS_STEPS == 0) {
+                        Log::log_message(Log::Log_Priority::INFO, "hogwild_train_new_model",
+                            std::format("Hogwild trainer epoch {} step {} loss={}", i, j - slice_start, loss));
+                    }
+                }
+            }
+        };
+        pool.run(num_threads, train_slice);
+
         free(shuffled_index);
     }
+
+    report_training("hogwild_train_new_model", nn, images, labels, num_training_images * epochs,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        delete current_images[i];
+        delete current_labels[i];
+        delete workspaces[i];
+    }
+    free(current_images);
+    free(current_labels);
+    free(workspaces);
+
     nn.save(model_path);
 }
 
+void MNIST_Training_NS::batch_train_new_model(const char* labels_path, const char* images_path, 
+    const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t num_training_images, 
+    size_t batch_size, size_t epochs, Neural_Network_NS::Cost_Function cost_function, size_t num_threads,
+    const char* model_path, MNIST_Utils_NS::Pixel_Format pixel_format) {
+
+    MNIST_Images images = MNIST_Images(images_path, pixel_format);
+    MNIST_Labels labels = MNIST_Labels(labels_path);
+
+    if (layer_info.size() == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "batch_train_new_model",
+            "Invalid layer_info vector provided");
+        return;
+    }
+
+    if (batch_size == 0 || num_threads == 0 || num_training_images < batch_size
+        || num_training_images > images.size()) {
+        Log::log_message(Log::Log_Priority::ERROR, "batch_train_new_model",
+            std::format("Invalid batch setup: {} images, batch size {}, {} threads",
+                num_training_images, batch_size, num_threads));
+        return;
+    }
+
+    if (pixel_format == MNIST_Utils_NS::Pixel_Format::RAW && num_threads > 1) {
+        Log::log_message(Log::Log_Priority::ERROR, "batch_train_new_model",
+            "Raw pixels are only supported when training on a single thread");
+        return;
+    }
+
+    // Instantiate the Neural Network
+    Neural_Network nn = Neural_Network(layer_info, learning_rate, lambda, cost_function);
+
+    const size_t num_batches = num_training_images / batch_size;
+
+    // Loader threads gather the batches ahead of the trainer, from a new shuffle of the images each epoch
+    size_t* schedule = create_schedule(num_training_images, num_batches * batch_size, epochs);
+    Batch_Pipeline pipeline = Batch_Pipeline(images, labels, batch_size, schedule, num_batches * epochs,
+        MNIST_TRAINING_LOADER_THREADS, MNIST_TRAINING_PIPELINE_SLOTS);
+    free(schedule);
+
+    // Track the loss
+    float loss = 0;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < epochs; ++i) {
+
+        for (size_t j = 0; j < num_batches; ++j) {
+
+            const Batch_Pipeline_Slot& current = pipeline.acquire();
+
+            if (current.raw_images != NULL) {
+                loss = nn.batch_train(*(current.raw_images), *(current.labels), num_training_images);
+            }
+            else if (num_threads > 1) {
+                loss = nn.parallel_batch_train(*(current.images), *(current.labels), num_training_images,
+                    num_threads);
+            }
+            else {
+                loss = nn.batch_train(*(current.images), *(current.labels), num_training_images);
+            }
+            pipeline.release();
+
+            if (MNIST_TRAINING_SHOW_LOSS) {
+                if (j % MNIST_TRAINING_SHOW_BATCH_LOSS_STEPS == 0) {
+                    Log::log_message(Log::Log_Priority::INFO, "batch_train_new_model",
+                        std::format("Batch trainer epoch {} step {} loss={}", i, j, loss));
+                }
+            }
+        }
+    }
+
+    Log::log_message(Log::Log_Priority::INFO, "batch_train_new_model",
+        std::format("Waited on the loaders for {} of {} batches", pipeline.stalls(), num_batches * epochs));
+
+    report_training("batch_train_new_model", nn, images, labels, num_batches * batch_size * epochs,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+
+    nn.save(model_path);
+}
+
+void MNIST_Training_NS::stream_train_new_model(const char* labels_path, const char* images_path,
+    const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t batch_size,
+    size_t epochs, Neural_Network_NS::Cost_Function cost_function, const char* model_path) {
+
+    MNIST_Stream stream = MNIST_Stream(images_path, labels_path);
+
+    if (layer_info.size() == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "stream_train_new_model",
+            "Invalid layer_info vector provided");
+        return;
+    }
+
+    if (batch_size == 0 || batch_size > stream.size()) {
+        Log::log_message(Log::Log_Priority::ERROR, "stream_train_new_model",
+            std::format("Invalid batch setup: {} images, batch size {}", stream.size(), batch_size));
+        return;
+    }
+
+    Log::log_message(Log::Log_Priority::INFO, "stream_train_new_model",
+        std::format("Streaming {} images through a {} byte buffer pool", stream.size(), stream.pool_bytes()));
+
+    // Instantiate the Neural Network
+    Neural_Network nn = Neural_Network(layer_info, learning_rate, lambda, cost_function);
+
+    Matrix current_images = Matrix(MNIST_IMAGE_SIZE, batch_size);
+    Matrix current_labels = Matrix(MNIST_LABELS, batch_size);
+
+    // Track the loss
+    float loss = 0;
+    size_t images_trained = 0;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < epochs; ++i) {
+
+        stream.begin_epoch();
+
+        for (size_t j = 0; stream.next_batch(current_images, current_labels); ++j) {
+
+            loss = nn.batch_train(current_images, current_labels, stream.size());
+            images_trained += batch_size;
+
+            if (MNIST_TRAINING_SHOW_LOSS) {
+                if (j % MNIST_TRAINING_SHOW_BATCH_LOSS_STEPS == 0) {
+                    Log::log_message(Log::Log_Priority::INFO, "stream_train_new_model",
+                        std::format("Stream trainer epoch {} step {} loss={}", i, j, loss));
+                }
+            }
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    Log::log_message(Log::Log_Priority::INFO, "stream_train_new_model",
+        std::format("Trained on {} images in {:.2f}s ({:.0f} images/s)", images_trained, seconds,
+            (seconds > 0) ? (double)images_trained / seconds : 0.0));
+
+    // Check the accuracy through the stream as well, in file order so each chunk is read once
+    Matrix current_image = Matrix(MNIST_IMAGE_SIZE, 1);
+    Matrix prediction = Matrix(MNIST_LABELS, 1);
+    size_t correct = 0;
+
+    for (size_t i = 0; i < stream.size(); ++i) {
+        stream.get_flat(i, current_image);
+        nn.inference(current_image, prediction);
+
+        if (prediction.max_idx(Matrix_NS::COLUMN, 0) == (size_t)stream.get_label(i)) {
+            ++correct;
+        }
+    }
+
+    Log::log_message(Log::Log_Priority::INFO, "stream_train_new_model",
+        std::format("Training set accuracy: {:.2f}%", 100.0f * (float)correct / (float)stream.size()));
+
+    nn.save(model_path);
+}
+
+float MNIST_Training_NS::calculate_accuracy(const Neural_Network& nn, const MNIST_Images& images,
+    const MNIST_Labels& labels, size_t num_images) {
+
+    if (num_images == 0 || num_images > images.size() || num_images > labels.size()) {
+        Log::log_message(Log::Log_Priority::ERROR, "calculate_accuracy",
+            std::format("Cannot check {} images against a dataset of {}", num_images, images.size()));
+        return 0;
+    }
+
+    Matrix current_image = Matrix(MNIST_IMAGE_SIZE, 1);
+    Matrix prediction = Matrix(MNIST_LABELS, 1);
+    size_t correct = 0;
+
+    for (size_t i = 0; i < num_images; ++i) {
+        // Raw images are used in place, float images are copied out
+        if (images.format() == MNIST_Utils_NS::Pixel_Format::RAW) {
+            nn.inference(images.view_raw(i), prediction);
+        }
+        else {
+            images.get_flat(i, current_image);
+            nn.inference(current_image, prediction);
+        }
+
+        if (prediction.max_idx(Matrix_NS::COLUMN, 0) == (size_t)labels.get(i)) {
+            ++correct;
+        }
+    }
+
+    return (float)correct / (float)num_images;
+}
+
+size_t MNIST_Training_NS::threaded_predict(const Neural_Network& nn, const MNIST_Images& images,
+    const MNIST_Labels& labels, size_t num_images, size_t num_threads) {
+
+    if (num_images == 0 || num_images > images.size() || num_images > labels.size() || num_threads == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "threaded_predict",
+            std::format("Cannot predict {} images of {} on {} threads", num_images, images.size(), num_threads));
+        exit(EXIT_FAILURE);
+    }
+
+    const bool raw = images.format() == MNIST_Utils_NS::Pixel_Format::RAW;
+    const size_t num_chunks = (num_images + MNIST_TRAINING_PREDICT_CHUNK_SIZE - 1) / MNIST_TRAINING_PREDICT_CHUNK_SIZE;
+    const size_t outputs = nn.get_num_neurons(nn.get_num_layers() - 1);
+
+    // Never start more threads than there are chunks
+    num_threads = (num_threads < num_chunks) ? num_threads : num_chunks;
+
+    // Everything a thread touches is set up front, so the chunks themselves don't allocate
+    Predict_Worker* workers = new Predict_Worker[num_threads];
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers[i].context = nn.create_inference_context(MNIST_TRAINING_PREDICT_CHUNK_SIZE);
+        workers[i].results = (float*)calloc(outputs * MNIST_TRAINING_PREDICT_CHUNK_SIZE, sizeof(float));
+        workers[i].result_view = new Matrix(0, 0, NULL);
+
+        if (raw) {
+            workers[i].pixels = (uint8_t*)calloc(MNIST_IMAGE_SIZE * MNIST_TRAINING_PREDICT_CHUNK_SIZE, sizeof(uint8_t));
+            workers[i].pixel_view = new Byte_Matrix(0, 0, NULL);
+        }
+        else {
+            workers[i].inputs = (float*)calloc(MNIST_IMAGE_SIZE * MNIST_TRAINING_PREDICT_CHUNK_SIZE, sizeof(float));
+            workers[i].input_view = new Matrix(0, 0, NULL);
+        }
+
+        if (workers[i].results == NULL || (raw ? workers[i].pixels == NULL : workers[i].inputs == NULL)) {
+            Log::log_message(Log::Log_Priority::ERROR, "threaded_predict",
+                "Unable to allocate memory for the prediction buffers");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    auto predict_chunk = [&](size_t worker, size_t chunk) {
+        Predict_Worker& state = workers[worker];
+        const size_t start = chunk * MNIST_TRAINING_PREDICT_CHUNK_SIZE;
+        const size_t end = (start + MNIST_TRAINING_PREDICT_CHUNK_SIZE < num_images) ?
+            start + MNIST_TRAINING_PREDICT_CHUNK_SIZE : num_images;
+        const size_t columns = end - start;
+
+        state.result_view->rebind(outputs, columns, state.results);
+
+        // Raw pixels stay as bytes and are scaled inside the first layer's GEMM
+        if (raw) {
+            state.pixel_view->rebind(MNIST_IMAGE_SIZE, columns, state.pixels);
+            images.create_images_from_range(start, end, *(state.pixel_view));
+            nn.inference(*(state.pixel_view), *(state.result_view), *(state.context));
+        }
+        else {
+            state.input_view->rebind(MNIST_IMAGE_SIZE, columns, state.inputs);
+            images.create_images_from_range(start, end, *(state.input_view));
+            nn.inference(*(state.input_view), *(state.result_view), *(state.context));
+        }
+
+        for (size_t i = 0; i < columns; ++i) {
+            if (column_argmax(*(state.result_view), i) == (size_t)labels.get(start + i)) {
+                ++state.correct;
+            }
+        }
+    };
+
+    Thread_Pool pool(num_threads);
+    pool.run_stealing(num_chunks, predict_chunk);
+
+    size_t correct = 0;
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        correct += workers[i].correct;
+
+        delete workers[i].context;
+        delete workers[i].result_view;
+        free(workers[i].results);
+        if (workers[i].pixel_view != NULL) { delete workers[i].pixel_view; }
+        if (workers[i].input_view != NULL) { delete workers[i].input_view; }
+        free(workers[i].pixels);
+        free(workers[i].inputs);
+    }
+    delete[] workers;
+
+    return correct;
+}
+
+void MNIST_Training_NS::predict_model(const char* labels_path, const char* images_path, size_t num_images,
+    const char* model_path, size_t num_threads) {
+
+    // Raw pixels skip converting the whole dataset to floats before the first prediction
+    MNIST_Images images = MNIST_Images(images_path, MNIST_Utils_NS::Pixel_Format::RAW);
+    MNIST_Labels labels = MNIST_Labels(labels_path);
+    Neural_Network nn = Neural_Network(model_path);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t correct = threaded_predict(nn, images, labels, num_images, num_threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Log::log_message(Log::Log_Priority::INFO, "predict_model",
+        std::format("Predicted {} images on {} threads in {:.3f}s ({:.0f} images/s)", num_images, num_threads,
+            seconds, (seconds > 0) ? (double)num_images / seconds : 0.0));
+
+    std::cout << "\nStatistics:\n";
+    std::cout << "Model path: " << model_path << "\n";
+    std::cout << "Images predicted: " << num_images << "\n";
+    std::cout << "Images predicted correctly: " << correct << "\n";
+    std::cout << std::format("Percentage correct: {:.5f}%\n", 100.0 * (double)correct / (double)num_images);
+}
+
+void MNIST_Training_NS::benchmark_latency(const char* images_path, const char* model_path, size_t iterations) {
+
+    if (iterations == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "benchmark_latency",
+            "Cannot benchmark zero iterations");
+        exit(EXIT_FAILURE);
+    }
+
+    MNIST_Images images = MNIST_Images(images_path, MNIST_Utils_NS::Pixel_Format::RAW);
+    Neural_Network nn = Neural_Network(model_path);
+
+    Matrix result = Matrix(nn.get_num_neurons(nn.get_num_layers() - 1), 1);
+    std::vector<double> latencies(iterations);
+
+    // Warm up the thread's inference context and the caches before timing anything
+    for (size_t i = 0; i < MNIST_TRAINING_LATENCY_WARMUP; ++i) {
+        nn.inference(images.view_raw(i % images.size()), result);
+    }
+
+    for (size_t i = 0; i < iterations; ++i) {
+        const Byte_Matrix image = images.view_raw(i % images.size());
+
+        auto start = std::chrono::steady_clock::now();
+        nn.inference(image, result);
+        latencies[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double total = 0;
+    for (size_t i = 0; i < iterations; ++i) { total += latencies[i]; }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    // Nearest-rank percentiles over the sorted samples
+    auto percentile = [&latencies, iterations](double p) {
+        size_t rank = (size_t)((p / 100.0) * (double)iterations + 0.5);
+        return latencies[(rank == 0) ? 0 : ((rank > iterations) ? iterations : rank) - 1];
+    };
+
+    std::cout << "\nStatistics:\n";
+    std::cout << "Model path: " << model_path << "\n";
+    std::cout << "Instruction set: "
+        << Matrix_Kernels_NS::instruction_set_name(Matrix_Kernels_NS::kernels().instruction_set) << "\n";
+    std::cout << "Single-image inferences: " << iterations << "\n";
+    std::cout << std::format("Median latency: {:.2f}us\n", percentile(50));
+    std::cout << std::format("p99 latency: {:.2f}us\n", percentile(99));
+    std::cout << std::format("Mean latency: {:.2f}us\n", total / (double)iterations);
+    std::cout << std::format("Max latency: {:.2f}us\n", latencies[iterations - 1]);
+}
+
+void MNIST_Training_NS::report_training(const char* caller, const Neural_Network& nn, const MNIST_Images& images,
+    const MNIST_Labels& labels, size_t images_trained, double seconds) {
+
+    Log::log_message(Log::Log_Priority::INFO, caller,
+        std::format("Trained on {} images in {:.2f}s ({:.0f} images/s)", images_trained, seconds,
+            (seconds > 0) ? (double)images_trained / seconds : 0.0));
+
+    Log::log_message(Log::Log_Priority::INFO, caller,
+        std::format("Training set accuracy: {:.2f}%", 100.0f * calculate_accuracy(nn, images, labels, images.size())));
+}
+
 void MNIST_Training_NS::shuffle(size_t* index, size_t elements) {
 
     if (index == NULL) {
@@ -91,6 +591,30 @@ void MNIST_Training_NS::shuffle(size_t* index, size_t elements) {
     }
 }
 
+size_t* MNIST_Training_NS::create_schedule(size_t elements, size_t per_epoch, size_t epochs) {
+
+    if (per_epoch > elements) {
+        Log::log_message(Log::Log_Priority::ERROR, "create_schedule",
+            std::format("Cannot take {} entries per epoch from {} elements", per_epoch, elements));
+        exit(EXIT_FAILURE);
+    }
+
+    size_t* target = (size_t*)calloc((per_epoch * epochs) + 1, sizeof(size_t));
+
+    if (target == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "create_schedule",
+            "Unable to allocate memory for the schedule");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < epochs; ++i) {
+        size_t* shuffled_index = create_index_array(elements);
+        memcpy(target + (i * per_epoch), shuffled_index, per_epoch * sizeof(size_t));
+        free(shuffled_index);
+    }
+    return target;
+}
+
 size_t* MNIST_Training_NS::create_index_array(size_t elements) {
 
     size_t* target = (size_t*)calloc(elements, sizeof(size_t));
@@ -8,7 +8,7 @@
  *                                                                                                               
  * Project: Basic Neural Network in C++
  * @author : Samuel Andersen
- * @version: 2025-07-21
+ * @version: 2026-10-17
  *
  * General Notes:
  *
@@ -20,6 +20,210 @@
 
 using MNIST_Utils_NS::MNIST_Images;
 using MNIST_Utils_NS::MNIST_Labels;
+using MNIST_Utils_NS::IDX_File;
+using MNIST_Utils_NS::Pixel_Format;
+
+/**
+ * Turn consecutive images (one per row, as stored) into one image per column, as the network
+ * takes them. A single image is already a column and is just copied
+ * @param source Pointer to the first image
+ * @param num_images Number of images
+ * @param target Destination, MNIST_IMAGE_SIZE x num_images
+ */
+template <typename Pixel_Type>
+static void transpose_images(const Pixel_Type* source, size_t num_images, Pixel_Type* target) {
+
+    if (num_images == 1) {
+        memcpy(target, source, MNIST_IMAGE_SIZE * sizeof(Pixel_Type));
+        return;
+    }
+
+    // Transpose a tile at a time: MNIST_IMAGES_TRANSPOSE_BLOCK images are read side by side
+    // and written as contiguous row segments
+    for (size_t i = 0; i < num_images; i += MNIST_IMAGES_TRANSPOSE_BLOCK) {
+        const size_t block_images = (i + MNIST_IMAGES_TRANSPOSE_BLOCK < num_images) ?
+            MNIST_IMAGES_TRANSPOSE_BLOCK : num_images - i;
+        const Pixel_Type* block = source + (i * MNIST_IMAGE_SIZE);
+
+        for (size_t k = 0; k < MNIST_IMAGE_SIZE; ++k) {
+            Pixel_Type* row = target + (k * num_images) + i;
+            for (size_t j = 0; j < block_images; ++j) {
+                row[j] = block[(j * MNIST_IMAGE_SIZE) + k];
+            }
+        }
+    }
+}
+
+/**
+ * Gather images, given by index, into one image per column. Works a tile of
+ * MNIST_IMAGES_TRANSPOSE_BLOCK images at a time like transpose_images(). Shuffled indices
+ * defeat the hardware prefetcher, so the next tile is prefetched while the current one is written
+ * @param source Pointer to the first image in the store
+ * @param indices Indices of the images to gather
+ * @param num_images Total number of columns in target
+ * @param first_block First tile to gather
+ * @param last_block One past the last tile to gather
+ * @param target Destination, MNIST_IMAGE_SIZE x num_images
+ */
+template <typename Pixel_Type>
+static void gather_blocks(const Pixel_Type* source, const size_t* indices, size_t num_images,
+    size_t first_block, size_t last_block, Pixel_Type* target) {
+
+    constexpr size_t line_pixels = MNIST_IMAGES_ALIGNMENT / sizeof(Pixel_Type);
+    const Pixel_Type* block[MNIST_IMAGES_TRANSPOSE_BLOCK];
+    const Pixel_Type* next_block[MNIST_IMAGES_TRANSPOSE_BLOCK];
+
+    for (size_t b = first_block; b < last_block; ++b) {
+        const size_t i = b * MNIST_IMAGES_TRANSPOSE_BLOCK;
+        const size_t block_images = (i + MNIST_IMAGES_TRANSPOSE_BLOCK < num_images) ?
+            MNIST_IMAGES_TRANSPOSE_BLOCK : num_images - i;
+        const size_t next_images = (b + 1 < last_block) ?
+            ((i + (2 * MNIST_IMAGES_TRANSPOSE_BLOCK) < num_images) ?
+                MNIST_IMAGES_TRANSPOSE_BLOCK : num_images - i - MNIST_IMAGES_TRANSPOSE_BLOCK) : 0;
+
+        for (size_t j = 0; j < block_images; ++j) {
+            block[j] = source + (indices[i + j] * MNIST_IMAGE_SIZE);
+        }
+        for (size_t j = 0; j < next_images; ++j) {
+            next_block[j] = source + (indices[i + MNIST_IMAGES_TRANSPOSE_BLOCK + j] * MNIST_IMAGE_SIZE);
+        }
+
+        for (size_t k = 0; k < MNIST_IMAGE_SIZE; ++k) {
+            // Fetch the next tile's copy of the current cache line, spread over the rows of that
+            // line so only a few prefetches are in flight at once
+            for (size_t j = k % line_pixels; j < next_images; j += line_pixels) {
+                __builtin_prefetch(next_block[j] + (k - (k % line_pixels)), 0, 3);
+            }
+
+            Pixel_Type* row = target + (k * num_images) + i;
+            for (size_t j = 0; j < block_images; ++j) {
+                row[j] = block[j][k];
+            }
+        }
+    }
+}
+
+/**
+ * Gather images, given by index, into one image per column, splitting the tiles across a
+ * Thread_Pool for large gathers
+ * @param source Pointer to the first image in the store
+ * @param indices Indices of the images to gather
+ * @param num_images Number of images
+ * @param target Destination, MNIST_IMAGE_SIZE x num_images
+ * @param pool Thread_Pool to use, or NULL to gather on the calling thread
+ */
+template <typename Pixel_Type>
+static void gather_images(const Pixel_Type* source, const size_t* indices, size_t num_images,
+    Pixel_Type* target, Thread_Pool_NS::Thread_Pool* pool) {
+
+    const size_t num_blocks = (num_images + MNIST_IMAGES_TRANSPOSE_BLOCK - 1) / MNIST_IMAGES_TRANSPOSE_BLOCK;
+
+    if (pool == NULL || pool->size() < 2 || num_images < MNIST_IMAGES_GATHER_PARALLEL_MIN) {
+        gather_blocks(source, indices, num_images, 0, num_blocks, target);
+        return;
+    }
+
+    // Every task writes its own range of columns, so they never overlap
+    const size_t num_tasks = (pool->size() < num_blocks) ? pool->size() : num_blocks;
+    auto gather = [&](size_t task) {
+        gather_blocks(source, indices, num_images, (task * num_blocks) / num_tasks,
+            ((task + 1) * num_blocks) / num_tasks, target);
+    };
+    pool->run(num_tasks, gather);
+}
+
+/**
+ * Checksum used by the image cache: FNV-1a style over 64-bit words, in four independent lanes
+ * so the multiplies overlap
+ * @param data Pointer to the bytes to checksum
+ * @param bytes Number of bytes
+ * @returns Returns the 64-bit checksum
+ */
+static uint64_t cache_checksum(const void* data, size_t bytes) {
+
+    const uint64_t prime = 0x100000001B3ULL;
+    uint64_t lanes[4] = {0xCBF29CE484222325ULL, 0x84222325CBF29CE4ULL, 0x9CE484222325CBF2ULL, 0x2325CBF29CE48422ULL};
+    const uint8_t* current = (const uint8_t*)data;
+
+    size_t i = 0;
+    for (; i + (4 * sizeof(uint64_t)) <= bytes; i += 4 * sizeof(uint64_t)) {
+        for (size_t j = 0; j < 4; ++j) {
+            uint64_t word;
+            memcpy(&word, current + i + (j * sizeof(uint64_t)), sizeof(uint64_t));
+            lanes[j] = (lanes[j] ^ word) * prime;
+        }
+    }
+    for (; i < bytes; ++i) {
+        lanes[0] = (lanes[0] ^ current[i]) * prime;
+    }
+
+    uint64_t result = lanes[0];
+    for (size_t j = 1; j < 4; ++j) {
+        result = (result ^ lanes[j]) * prime;
+    }
+    return result ^ (uint64_t)bytes;
+}
+
+/**
+ * Build the header for a cache file or shared segment holding decoded images
+ * @param source stat() of the IDX file the images came from
+ * @param num_images Number of images
+ * @param images Pointer to the decoded images
+ * @returns Returns the filled in header
+ */
+static MNIST_Utils_NS::MNIST_Images_Cache_Header create_cache_header(const struct stat& source,
+    size_t num_images, const float* images) {
+
+    MNIST_Utils_NS::MNIST_Images_Cache_Header header;
+    memset(&header, 0, sizeof(header));
+
+    header.magic = MNIST_IMAGES_CACHE_MAGIC;
+    header.version = MNIST_IMAGES_CACHE_VERSION;
+    header.source_size = (uint64_t)source.st_size;
+    header.source_mtime_sec = (int64_t)source.st_mtim.tv_sec;
+    header.source_mtime_nsec = (int64_t)source.st_mtim.tv_nsec;
+    header.num_images = num_images;
+    header.payload_size = num_images * MNIST_IMAGE_SIZE * sizeof(float);
+    header.payload_checksum = cache_checksum(images, header.payload_size);
+    header.header_checksum = cache_checksum(&header, offsetof(MNIST_Utils_NS::MNIST_Images_Cache_Header, header_checksum));
+
+    return header;
+}
+
+/**
+ * Check a cache header against the IDX file it should have been built from
+ * @param header The header to check
+ * @param source stat() of the IDX file
+ * @param available Total bytes in the cache file or shared segment, header included
+ * @returns Returns true if the header is intact, matches the source and the pixels are all there
+ */
+static bool cache_header_valid(const MNIST_Utils_NS::MNIST_Images_Cache_Header& header, const struct stat& source,
+    size_t available) {
+
+    return header.magic == MNIST_IMAGES_CACHE_MAGIC &&
+        header.version == MNIST_IMAGES_CACHE_VERSION &&
+        header.header_checksum == cache_checksum(&header, offsetof(MNIST_Utils_NS::MNIST_Images_Cache_Header, header_checksum)) &&
+        header.source_size == (uint64_t)source.st_size &&
+        header.source_mtime_sec == (int64_t)source.st_mtim.tv_sec &&
+        header.source_mtime_nsec == (int64_t)source.st_mtim.tv_nsec &&
+        header.num_images != 0 &&
+        header.payload_size == header.num_images * MNIST_IMAGE_SIZE * sizeof(float) &&
+        (uint64_t)available >= MNIST_IMAGES_CACHE_HEADER_SIZE + header.payload_size;
+}
+
+/**
+ * Name of the shared memory segment for an IDX file. The name covers the file's identity and
+ * version, so an edited dataset gets a fresh segment instead of changing one that is mapped
+ * @param source stat() of the IDX file
+ * @returns Returns the name to pass to shm_open()
+ */
+static std::string shared_segment_name(const struct stat& source) {
+
+    const uint64_t identity[5] = {(uint64_t)source.st_dev, (uint64_t)source.st_ino, (uint64_t)source.st_size,
+        (uint64_t)source.st_mtim.tv_sec, (uint64_t)source.st_mtim.tv_nsec};
+
+    return std::format("{}{:016x}", MNIST_IMAGES_SHARED_PREFIX, cache_checksum(identity, sizeof(identity)));
+}
 
 bool MNIST_Images::exists(size_t index) const {
     if (index >= m_num_images) {
@@ -37,113 +241,316 @@ bool MNIST_Images::exists(size_t index) const {
             "m_images is NULL");
         return false;
     }
-    if (m_images[index] == NULL) {
-        Log::log_message(Log::Log_Priority::WARNING, "MNIST_Images::exists",
-            std::format("Requested index {} is NULL", index));
-        return false;
-    }
     return true;
 }
 
-MNIST_Images::MNIST_Images(const char* path) {
+MNIST_Images::MNIST_Images(const char* path, Pixel_Format format) {
 
-    // Open the path to where the images are stored, in read-only mode
-    FILE* images_file = fopen(path, "ro");
+    if (format == Pixel_Format::SHARED) {
+        if (attach_shared(path)) {
+            m_format = format;
+            if (MNIST_UTILS_DEBUG) {
+                Log::log_message(Log::Log_Priority::INFO, "MNIST_Images::MNIST_Images",
+                    std::format("Reading {} images from shared memory", m_num_images));
+            }
+            return;
+        }
 
-    if (images_file == NULL) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::MNIST_Images",
-            std::format("Unable to open path '{}' to MNIST images. Exiting...",
-                path));
-        exit(EXIT_FAILURE);
+        Log::log_message(Log::Log_Priority::WARNING, "MNIST_Images::MNIST_Images",
+            "Unable to use shared memory, falling back to a private copy of the images");
+        format = Pixel_Format::FLOAT;
     }
 
-    // We want to read in four values at once here to avoid using fread again and again
-    uint32_t image_buffer[4] = {0, 0, 0, 0};
+    // Decoding the IDX file dominates startup, so reuse a previous run's floats when we can
+    struct stat source_info;
+    const std::string cache_path = std::string(path) + MNIST_IMAGES_CACHE_SUFFIX;
+    const bool use_cache = MNIST_IMAGES_USE_CACHE && format == Pixel_Format::FLOAT && stat(path, &source_info) == 0;
 
-    // Read in 16 bytes from the file, grabbing the magic number and the number of items contained
-    if (fread(&image_buffer, sizeof(uint32_t), 4, images_file) != 4) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::MNIST_Images",
-            "Unable to read headers from MNIST images file");
-        fclose(images_file);
-        exit(EXIT_FAILURE);
+    if (use_cache && map_cache(cache_path.c_str(), source_info)) {
+        m_format = format;
+        if (MNIST_UTILS_DEBUG) {
+            Log::log_message(Log::Log_Priority::INFO, "MNIST_Images::MNIST_Images",
+                std::format("Reading {} images from '{}'", m_num_images, cache_path));
+        }
+        return;
     }
 
-    // The first entry in the array is used for the magic number; the second is for the number of items
-    if (map_uint32(image_buffer[0]) != MNIST_IMAGE_MAGIC) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::MNIST_Images",
-            "Mismatched magic number in the MNIST images file header");
-        fclose(images_file);
-        exit(EXIT_FAILURE);
-    }
+    // Map the file and check the magic number
+    IDX_File* images_file = new IDX_File(path, MNIST_IMAGE_MAGIC);
 
     // Validate the image size matches what we are expecting
-    if (map_uint32(image_buffer[2]) != MNIST_IMAGE_HEIGHT || map_uint32(image_buffer[3]) != MNIST_IMAGE_WIDTH) {
+    if (images_file->dimension(1) != MNIST_IMAGE_HEIGHT || images_file->dimension(2) != MNIST_IMAGE_WIDTH) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::MNIST_Images",
             std::format("Unexpected image dimensions provided. Check MNIST_Utils.hpp. Detected [{} x {}] but expected [{} x {}]",
-                map_uint32(image_buffer[2]), map_uint32(image_buffer[3]), MNIST_IMAGE_HEIGHT, MNIST_IMAGE_WIDTH));
-        fclose(images_file);
+                images_file->dimension(1), images_file->dimension(2), MNIST_IMAGE_HEIGHT, MNIST_IMAGE_WIDTH));
+        delete images_file;
         exit(EXIT_FAILURE);
     }
 
     // Store the information regarding the images
-    m_num_images = (size_t)map_uint32(image_buffer[1]);
+    m_num_images = images_file->count();
+    m_format = format;
     if (MNIST_UTILS_DEBUG) {
         Log::log_message(Log::Log_Priority::INFO, "MNIST_Images::MNIST_Images",
             std::format("Reading {} images", m_num_images));
     }
 
-    // Allocate memory for storing the image Matrix instances
-    m_images = (Matrix**)calloc(m_num_images, sizeof(Matrix*));
+    // Raw pixels are served straight from the mapping, so there is nothing else to do
+    if (format == Pixel_Format::RAW) {
+        m_file = images_file;
+        return;
+    }
+
+    // One aligned buffer for every image. Large stores are aligned to huge pages, which cuts the
+    // page faults taken while filling it (and TLB misses afterwards). aligned_alloc needs the size
+    // to be a multiple of the alignment
+    size_t store_bytes = m_num_images * MNIST_IMAGE_SIZE * sizeof(float);
+    const size_t alignment = (store_bytes >= MNIST_IMAGES_HUGE_PAGE) ? MNIST_IMAGES_HUGE_PAGE : MNIST_IMAGES_ALIGNMENT;
+    store_bytes = ((store_bytes + alignment - 1) / alignment) * alignment;
+
+    m_images = (float*)aligned_alloc(alignment, (store_bytes == 0) ? alignment : store_bytes);
     if (m_images == NULL) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::MNIST_Images",
             "Unable to allocate memory for storing image data");
-        fclose(images_file);
+        delete images_file;
         exit(EXIT_FAILURE);
     }
+#ifdef MADV_HUGEPAGE
+    // Only a hint, regular pages work just as well if huge pages are unavailable
+    if (alignment == MNIST_IMAGES_HUGE_PAGE) {
+        madvise(m_images, store_bytes, MADV_HUGEPAGE);
+    }
+#endif
 
-    uint8_t pixel_value = 0;
+    // The whole file is one run of pixels, so normalize it in a single vectorized pass.
+    // Dividing (rather than multiplying by 1 / 255) keeps the results identical to pixel_to_float
+    Matrix_Kernels_NS::kernels().convert_u8(images_file->payload(), 255.0f, m_images,
+        m_num_images * MNIST_IMAGE_SIZE);
+
+    // Cleanup
+    delete images_file;
 
-    for (uint32_t i = 0; i < m_num_images; ++i) {
+    if (use_cache) {
+        write_cache(cache_path.c_str(), source_info);
+    }
+}
 
-        // For each expected image, create a new Matrix to store it in
-        m_images[i] = new Matrix(MNIST_IMAGE_HEIGHT, MNIST_IMAGE_WIDTH);
+bool MNIST_Images::map_cache(const char* cache_path, const struct stat& source) {
 
-        // For each expected pixel, grab the value and store it in the Matrix
-        for (size_t j = 0; j < MNIST_IMAGE_HEIGHT; ++j) {
-            for (size_t k = 0; k < MNIST_IMAGE_WIDTH; ++k) {
-                if (fread(&pixel_value, sizeof(uint8_t), 1, images_file) != 1) {
-                    Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::MNIST_Images",
-                        "Failed to read pixel data");
-                    if (MNIST_UTILS_DEBUG) {
-                        Log::log_message(Log::Log_Priority::DEBUG, "MNIST_Images::MNIST_Images",
-                            std::format("Failed to read pixel @ index ({}, {}, {})", i, j, k));
-                    }
-                    fclose(images_file);
-                    exit(EXIT_FAILURE);
-                }
-                // Copy the value of the pixel intensity to the newly created Matrix
-                m_images[i]->set(j, k, pixel_to_float(&pixel_value));
-            }
+    int file = open(cache_path, O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    MNIST_Images_Cache_Header header;
+    struct stat file_info;
+
+    if (fstat(file, &file_info) != 0 ||
+        pread(file, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+        close(file);
+        return false;
+    }
+
+    // Anything that doesn't line up means the cache is stale (or not ours) and gets rebuilt
+    const bool valid = cache_header_valid(header, source, (size_t)file_info.st_size);
+
+    if (!valid) {
+        close(file);
+        if (MNIST_UTILS_DEBUG) {
+            Log::log_message(Log::Log_Priority::INFO, "MNIST_Images::map_cache",
+                std::format("'{}' is out of date, rebuilding it", cache_path));
         }
+        return false;
     }
 
-    // Cleanup
-    fclose(images_file);
+    const size_t mapping_size = MNIST_IMAGES_CACHE_HEADER_SIZE + header.payload_size;
+    void* mapping = mmap(NULL, mapping_size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping holds its own reference to the file
+    close(file);
+
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const uint8_t* payload = (const uint8_t*)mapping + MNIST_IMAGES_CACHE_HEADER_SIZE;
+
+    if (MNIST_IMAGES_CACHE_VERIFY && cache_checksum(payload, header.payload_size) != header.payload_checksum) {
+        Log::log_message(Log::Log_Priority::WARNING, "MNIST_Images::map_cache",
+            std::format("Checksum mismatch in '{}', rebuilding it", cache_path));
+        munmap(mapping, mapping_size);
+        return false;
+    }
+
+    // Start reading ahead now, the pixels will all be needed
+    madvise(mapping, mapping_size, MADV_WILLNEED);
+
+    m_cache_mapping = mapping;
+    m_cache_mapping_size = mapping_size;
+    m_images = (float*)payload;
+    m_num_images = header.num_images;
+
+    return true;
 }
 
-MNIST_Images::~MNIST_Images() {
+void MNIST_Images::write_cache(const char* cache_path, const struct stat& source) const {
 
-    if (m_images != NULL) {
-        for (size_t i = 0; i < m_num_images; ++i) {
-            if (m_images[i] != NULL) {
-                delete m_images[i];
-                m_images[i] = NULL;
-            }
-            else {
-                Log::log_message(Log::Log_Priority::WARNING, "MNIST_Images::~MNIST_Images",
-                    "NULL pointer detected when deallocated images. Skipping");
-            }
+    const size_t payload_size = m_num_images * MNIST_IMAGE_SIZE * sizeof(float);
+
+    // The header block is zero padded out to MNIST_IMAGES_CACHE_HEADER_SIZE
+    uint8_t header_block[MNIST_IMAGES_CACHE_HEADER_SIZE];
+    memset(header_block, 0, sizeof(header_block));
+
+    const MNIST_Images_Cache_Header header = create_cache_header(source, m_num_images, m_images);
+    memcpy(header_block, &header, sizeof(header));
+
+    // Write under a name unique to this process, then rename over the old cache in one step
+    const std::string temp_path = std::format("{}.{}.tmp", cache_path, (long)getpid());
+
+    int file = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        Log::log_message(Log::Log_Priority::WARNING, "MNIST_Images::write_cache",
+            std::format("Unable to create '{}', continuing without a cache", temp_path));
+        return;
+    }
+
+    bool written = write(file, header_block, sizeof(header_block)) == (ssize_t)sizeof(header_block);
+
+    // write() can return short, keep going until the whole payload is out
+    const uint8_t* payload = (const uint8_t*)m_images;
+    size_t done = 0;
+    while (written && done < payload_size) {
+        ssize_t result = write(file, payload + done, payload_size - done);
+        if (result <= 0) {
+            written = false;
+            break;
         }
+        done += (size_t)result;
+    }
+
+    written = (close(file) == 0) && written;
+
+    if (!written || rename(temp_path.c_str(), cache_path) != 0) {
+        Log::log_message(Log::Log_Priority::WARNING, "MNIST_Images::write_cache",
+            std::format("Unable to write '{}', continuing without a cache", cache_path));
+        unlink(temp_path.c_str());
+        return;
+    }
+
+    if (MNIST_UTILS_DEBUG) {
+        Log::log_message(Log::Log_Priority::INFO, "MNIST_Images::write_cache",
+            std::format("Wrote {} images to '{}'", m_num_images, cache_path));
+    }
+}
+
+bool MNIST_Images::attach_shared(const char* path) {
+
+    struct stat source;
+    if (stat(path, &source) != 0) {
+        return false;
+    }
+
+    const std::string name = shared_segment_name(source);
+    int segment = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (segment < 0) {
+        return false;
+    }
+
+    // Only one process builds the segment. Everyone else blocks here until it is published,
+    // and a segment left half built by a process that died is simply built again
+    if (flock(segment, LOCK_EX) != 0) {
+        close(segment);
+        return false;
+    }
+
+    MNIST_Images_Cache_Header header;
+    struct stat segment_info;
+    bool valid = fstat(segment, &segment_info) == 0 &&
+        (size_t)segment_info.st_size >= MNIST_IMAGES_CACHE_HEADER_SIZE &&
+        pread(segment, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+        cache_header_valid(header, source, (size_t)segment_info.st_size);
+
+    if (!valid) {
+        IDX_File images_file = IDX_File(path, MNIST_IMAGE_MAGIC);
+
+        if (images_file.dimension(1) != MNIST_IMAGE_HEIGHT || images_file.dimension(2) != MNIST_IMAGE_WIDTH) {
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::attach_shared",
+                std::format("Unexpected image dimensions provided. Detected [{} x {}] but expected [{} x {}]",
+                    images_file.dimension(1), images_file.dimension(2), MNIST_IMAGE_HEIGHT, MNIST_IMAGE_WIDTH));
+            exit(EXIT_FAILURE);
+        }
+
+        const size_t segment_size = MNIST_IMAGES_CACHE_HEADER_SIZE + (images_file.count() * MNIST_IMAGE_SIZE * sizeof(float));
+        void* mapping = MAP_FAILED;
+        if (ftruncate(segment, (off_t)segment_size) == 0) {
+            mapping = mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, segment, 0);
+        }
+        if (mapping == MAP_FAILED) {
+            flock(segment, LOCK_UN);
+            close(segment);
+            shm_unlink(name.c_str());
+            return false;
+        }
+
+#ifdef MADV_HUGEPAGE
+        madvise(mapping, segment_size, MADV_HUGEPAGE);
+#endif
+        float* pixels = (float*)((uint8_t*)mapping + MNIST_IMAGES_CACHE_HEADER_SIZE);
+        Matrix_Kernels_NS::kernels().convert_u8(images_file.payload(), 255.0f, pixels,
+            images_file.count() * MNIST_IMAGE_SIZE);
+
+        // The header goes in last, so the segment only becomes valid once the pixels are all there
+        header = create_cache_header(source, images_file.count(), pixels);
+        memcpy(mapping, &header, sizeof(header));
+        munmap(mapping, segment_size);
+
+        if (MNIST_UTILS_DEBUG) {
+            Log::log_message(Log::Log_Priority::INFO, "MNIST_Images::attach_shared",
+                std::format("Published {} images as '{}'", images_file.count(), name));
+        }
+    }
+
+    // Every process, including the one that built it, maps the segment read-only
+    const size_t mapping_size = MNIST_IMAGES_CACHE_HEADER_SIZE + header.payload_size;
+    void* mapping = mmap(NULL, mapping_size, PROT_READ, MAP_SHARED, segment, 0);
+
+    flock(segment, LOCK_UN);
+    // The mapping holds its own reference to the segment
+    close(segment);
+
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    m_cache_mapping = mapping;
+    m_cache_mapping_size = mapping_size;
+    m_images = (float*)((uint8_t*)mapping + MNIST_IMAGES_CACHE_HEADER_SIZE);
+    m_num_images = header.num_images;
+
+    return true;
+}
+
+bool MNIST_Images::remove_shared(const char* path) {
+
+    struct stat source;
+    if (stat(path, &source) != 0) {
+        return false;
+    }
+
+    return shm_unlink(shared_segment_name(source).c_str()) == 0;
+}
+
+MNIST_Images::~MNIST_Images() {
+
+    if (m_file != NULL) {
+        delete m_file;
+        m_file = NULL;
+    }
+    else if (m_cache_mapping != NULL) {
+        munmap(m_cache_mapping, m_cache_mapping_size);
+        m_cache_mapping = NULL;
+        m_images = NULL;
+    }
+    else if (m_images != NULL) {
         free(m_images);
         m_images = NULL;
     }
@@ -157,15 +564,66 @@ size_t MNIST_Images::size(void) const {
     return m_num_images;
 }
 
-const Matrix& MNIST_Images::get(size_t index) const {
+const Matrix MNIST_Images::get(size_t index) const {
+
+    return Matrix(MNIST_IMAGE_HEIGHT, MNIST_IMAGE_WIDTH, (float*)data(index));
+}
+
+Pixel_Format MNIST_Images::format(void) const {
+    return m_format;
+}
+
+const uint8_t* MNIST_Images::raw(size_t index) const {
+
+    if (m_file == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::raw",
+            "Raw pixels are only available when loading with Pixel_Format::RAW");
+        exit(EXIT_FAILURE);
+    }
+    if (index >= m_num_images) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::raw",
+            std::format("Index {} requested, but MNIST_Images ends at index {}", index, m_num_images - 1));
+        exit(EXIT_FAILURE);
+    }
+
+    return m_file->payload() + (index * MNIST_IMAGE_SIZE);
+}
+
+const Byte_Matrix MNIST_Images::view_raw(size_t index) const {
+
+    return Byte_Matrix(MNIST_IMAGE_SIZE, 1, (uint8_t*)raw(index));
+}
+
+const float* MNIST_Images::data(size_t index) const {
 
     if (!exists(index)) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::get",
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::data",
             "Invalid index provided. Exiting");
         exit(EXIT_FAILURE);
     }
 
-    return *(m_images[index]);
+    return m_images + (index * MNIST_IMAGE_SIZE);
+}
+
+const Matrix MNIST_Images::view(size_t index) const {
+
+    return Matrix(MNIST_IMAGE_SIZE, 1, (float*)data(index));
+}
+
+const Matrix MNIST_Images::view_range(size_t image_start, size_t image_end) const {
+
+    if (image_start >= image_end || image_end > m_num_images) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::view_range",
+           "Invalid range provided");
+        if (MNIST_UTILS_DEBUG) {
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::view_range",
+                std::format("Got range ({}, {}), but m_images ends at index {}",
+                    image_start, image_end, m_num_images - 1));
+        }
+        exit(EXIT_FAILURE);
+    }
+
+    return Matrix(image_end - image_start, MNIST_IMAGE_SIZE, (float*)data(image_start));
 }
 
 Matrix* MNIST_Images::get_flat(size_t index) const {
@@ -193,13 +651,13 @@ void MNIST_Images::get_flat(size_t index, Matrix& destination) const {
             "Incorrect destination Matrix size");
         exit(EXIT_FAILURE);
     }
-    get(index).copy_to(destination);
+    memcpy(destination.data(), data(index), MNIST_IMAGE_SIZE * sizeof(float));
     destination.flatten(Matrix_NS::Vector_Orientation::COLUMN);
 }
 
 Matrix* MNIST_Images::create_images_from_range(size_t image_start, size_t image_end) const {
 
-    if (image_start >= m_num_images || image_end >= m_num_images) {
+    if (image_start >= image_end || image_end > m_num_images) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::create_images_from_range",
            "Invalid range provided");
         if (MNIST_UTILS_DEBUG) {
@@ -223,7 +681,7 @@ Matrix* MNIST_Images::create_images_from_range(size_t image_start, size_t image_
 
 void MNIST_Images::create_images_from_range(size_t image_start, size_t image_end, Matrix& destination) const {
 
-    if (image_start >= m_num_images || image_end >= m_num_images) {
+    if (image_start >= image_end || image_end > m_num_images) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::create_images_from_range",
            "Invalid range provided");
         if (MNIST_UTILS_DEBUG) {
@@ -240,7 +698,7 @@ void MNIST_Images::create_images_from_range(size_t image_start, size_t image_end
     }
 
     size_t target_num_images = image_end - image_start;
-    if (destination.cols() != target_num_images) {
+    if (destination.rows() != MNIST_IMAGE_SIZE || destination.cols() != target_num_images) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::create_images_from_range",
             "Destination Matrix size incorrect");
         if (MNIST_UTILS_DEBUG){ 
@@ -251,14 +709,103 @@ void MNIST_Images::create_images_from_range(size_t image_start, size_t image_end
         exit(EXIT_FAILURE);
     }
 
-    // Iterate over the image Matrix instances and put into one giant Matrix
-    for (size_t i = 0; i < target_num_images; ++i) {
-        for (size_t j = 0; j < MNIST_IMAGE_HEIGHT; ++j) {
-            for (size_t k = 0; k < MNIST_IMAGE_WIDTH; ++k) {
-                destination.set((j * MNIST_IMAGE_WIDTH) + k, i, m_images[image_start + i]->get(j, k));
-            }
+    transpose_images(m_images + (image_start * MNIST_IMAGE_SIZE), target_num_images, destination.data());
+}
+
+void MNIST_Images::create_images_from_range(size_t image_start, size_t image_end, Byte_Matrix& destination) const {
+
+    if (image_start >= image_end || image_end > m_num_images) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::create_images_from_range",
+           "Invalid range provided");
+        if (MNIST_UTILS_DEBUG) {
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::create_images_from_range",
+                std::format("Got range ({}, {}), but m_images ends at index {}",
+                    image_start, image_end, m_num_images - 1));
+        } 
+        exit(EXIT_FAILURE);
+    }
+
+    size_t target_num_images = image_end - image_start;
+    if (destination.rows() != MNIST_IMAGE_SIZE || destination.cols() != target_num_images) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::create_images_from_range",
+            "Destination Matrix size incorrect");
+        if (MNIST_UTILS_DEBUG){ 
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::create_images_from_range",
+                std::format("Destination Matrix size [{} x {}] but should be [{} x {}]",
+                    destination.rows(), destination.cols(), MNIST_IMAGE_SIZE, target_num_images));
+        }
+        exit(EXIT_FAILURE);
+    }
+
+    transpose_images(raw(image_start), target_num_images, destination.data());
+}
+
+void MNIST_Images::gather_images(const size_t* indices, size_t num_indices, Matrix& destination,
+    Thread_Pool_NS::Thread_Pool* pool) const {
+
+    if (indices == NULL || num_indices == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+            "Invalid indices provided");
+        exit(EXIT_FAILURE);
+    }
+    if (m_images == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+            "m_images is NULL");
+        exit(EXIT_FAILURE);
+    }
+    if (destination.rows() != MNIST_IMAGE_SIZE || destination.cols() != num_indices) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+            "Destination Matrix size incorrect");
+        if (MNIST_UTILS_DEBUG){ 
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+                std::format("Destination Matrix size [{} x {}] but should be [{} x {}]",
+                    destination.rows(), destination.cols(), MNIST_IMAGE_SIZE, num_indices));
+        }
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < num_indices; ++i) {
+        if (indices[i] >= m_num_images) {
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+                std::format("Index {} requested, but m_images ends at index {}", indices[i], m_num_images - 1));
+            exit(EXIT_FAILURE);
         }
     }
+
+    ::gather_images(m_images, indices, num_indices, destination.data(), pool);
+}
+
+void MNIST_Images::gather_images(const size_t* indices, size_t num_indices, Byte_Matrix& destination,
+    Thread_Pool_NS::Thread_Pool* pool) const {
+
+    if (indices == NULL || num_indices == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+            "Invalid indices provided");
+        exit(EXIT_FAILURE);
+    }
+    if (m_format != Pixel_Format::RAW) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+            "Raw pixels are only kept for Pixel_Format::RAW");
+        exit(EXIT_FAILURE);
+    }
+    if (destination.rows() != MNIST_IMAGE_SIZE || destination.cols() != num_indices) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+            "Destination Matrix size incorrect");
+        if (MNIST_UTILS_DEBUG){ 
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+                std::format("Destination Matrix size [{} x {}] but should be [{} x {}]",
+                    destination.rows(), destination.cols(), MNIST_IMAGE_SIZE, num_indices));
+        }
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < num_indices; ++i) {
+        if (indices[i] >= m_num_images) {
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Images::gather_images",
+                std::format("Index {} requested, but m_images ends at index {}", indices[i], m_num_images - 1));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    ::gather_images(raw(0), indices, num_indices, destination.data(), pool);
 }
 
 bool MNIST_Labels::exists(size_t index) const {
@@ -283,61 +830,26 @@ bool MNIST_Labels::exists(size_t index) const {
 
 MNIST_Labels::MNIST_Labels(const char* path) {
 
-    // Open the path to where the labels are stored, in read-only mode
-    FILE* labels_file = fopen(path, "ro");
-
-    if (labels_file == NULL) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::MNIST_Labels",
-            std::format("Unable to open path '{}' to MNIST labels. Exiting...",
-                path));
-        exit(EXIT_FAILURE);
-    }
-
-    // We want to read in two values at once here to avoid using fread twice
-    uint32_t label_buffer[2] = {0, 0};
-
-    // Read in 8 bytes from the file, grabbing the magic number and number of items contained
-    if (fread(&label_buffer, sizeof(uint32_t), 2, labels_file) != 2) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::MNIST_Labels",
-            "Unable to read headers from MNIST label file");
-        fclose(labels_file);
-        exit(EXIT_FAILURE);
-    }
-
-    // The first entry in the array is used for the magic number; the second is the number of items
-    if (map_uint32(label_buffer[0]) != MNIST_LABEL_MAGIC) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::MNIST_Labels",
-            "Mistmatched magic number in the MNIST label file header");
-        fclose(labels_file);
-        exit(EXIT_FAILURE);
-    }
+    // Map the file and check the magic number
+    IDX_File labels_file = IDX_File(path, MNIST_LABEL_MAGIC);
 
     // Store the number of labels we are expecting
-    m_num_labels = (size_t)map_uint32(label_buffer[1]);
+    m_num_labels = labels_file.count();
     if (MNIST_UTILS_DEBUG) {
         Log::log_message(Log::Log_Priority::INFO, "MNIST_Labels::MNIST_Labels",
             std::format("Reading {} labels", m_num_labels));
     }
 
     // Allocate memory for storing the labels themselves
-    m_labels = (uint8_t*)calloc(m_num_labels, sizeof(uint8_t));
+    m_labels = (uint8_t*)calloc(m_num_labels + 1, sizeof(uint8_t));
     if (m_labels == NULL) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::MNIST_Labels",
             "Unable to allocate memory to store labels");
-        fclose(labels_file);
         exit(EXIT_FAILURE);
     }
 
-    // Read in all the labels at once
-    if (fread(m_labels, sizeof(uint8_t), m_num_labels, labels_file) != m_num_labels) {
-        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::MNIST_Labels",
-            "Failed to read labels");
-        fclose(labels_file);
-        exit(EXIT_FAILURE);
-    }
-
-    // Cleanup
-    fclose(labels_file);
+    // Copy all the labels at once
+    memcpy(m_labels, labels_file.payload(), m_num_labels);
 }
 
 MNIST_Labels::~MNIST_Labels() {
@@ -400,8 +912,8 @@ void MNIST_Labels::create_label(size_t index, Matrix& destination) const {
 
 Matrix* MNIST_Labels::create_labels_from_range(size_t label_start, size_t label_end) const {
 
-    // Only check for exceeding the m_num_labels since size_t can't ever be negative
-    if (label_start >= m_num_labels || label_end >= m_num_labels) {
+    // The range is [label_start, label_end), so label_end may equal m_num_labels
+    if (label_start >= label_end || label_end > m_num_labels) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::create_labels_from_range",
             "label_start or label_end is out of range.");
         if (MNIST_UTILS_DEBUG) {
@@ -424,8 +936,8 @@ Matrix* MNIST_Labels::create_labels_from_range(size_t label_start, size_t label_
 
 void MNIST_Labels::create_labels_from_range(size_t label_start, size_t label_end, Matrix& destination) const {
 
-    // Only check for exceeding the m_num_labels since size_t can't ever be negative
-    if (label_start >= m_num_labels || label_end >= m_num_labels) {
+    // The range is [label_start, label_end), so label_end may equal m_num_labels
+    if (label_start >= label_end || label_end > m_num_labels) {
         Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::create_labels_from_range",
             "label_start or label_end is out of range.");
         if (MNIST_UTILS_DEBUG) {
@@ -464,6 +976,143 @@ void MNIST_Labels::create_labels_from_range(size_t label_start, size_t label_end
     }
 }
 
+void MNIST_Labels::gather_labels(const size_t* indices, size_t num_indices, Matrix& destination) const {
+
+    if (indices == NULL || num_indices == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::gather_labels",
+            "Invalid indices provided");
+        exit(EXIT_FAILURE);
+    }
+    if (m_labels == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::gather_labels",
+            "m_labels is NULL. Not returning a value");
+        exit(EXIT_FAILURE);
+    }
+    if (destination.rows() != MNIST_LABELS || destination.cols() != num_indices) {
+        Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::gather_labels",
+            "Number of labels to process and size of destination Matrix do not match");
+        exit(EXIT_FAILURE);
+    }
+
+    // Clear out the contents of the destination Matrix
+    destination.populate(0);
+
+    for (size_t i = 0; i < num_indices; ++i) {
+        if (indices[i] >= m_num_labels) {
+            Log::log_message(Log::Log_Priority::ERROR, "MNIST_Labels::gather_labels",
+                std::format("Index {} requested, but max index is {}", indices[i], m_num_labels - 1));
+            exit(EXIT_FAILURE);
+        }
+        destination.set((size_t)m_labels[indices[i]], i, 1.0f);
+    }
+}
+
+IDX_File::IDX_File(const char* path, uint32_t magic) {
+
+    int file = open(path, O_RDONLY);
+    if (file < 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::IDX_File",
+            std::format("Unable to open path '{}'. Exiting...", path));
+        exit(EXIT_FAILURE);
+    }
+
+    struct stat file_info;
+    if (fstat(file, &file_info) != 0 || file_info.st_size < (off_t)sizeof(uint32_t)) {
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::IDX_File",
+            std::format("Unable to read headers from '{}'", path));
+        close(file);
+        exit(EXIT_FAILURE);
+    }
+
+    m_mapping_size = (size_t)file_info.st_size;
+    m_mapping = mmap(NULL, m_mapping_size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping holds its own reference to the file
+    close(file);
+
+    if (m_mapping == MAP_FAILED) {
+        m_mapping = NULL;
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::IDX_File",
+            std::format("Unable to map '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+
+    // Everything is read front to back exactly once. Advice values are not flags, so each one
+    // needs its own call
+    madvise(m_mapping, m_mapping_size, MADV_SEQUENTIAL);
+    madvise(m_mapping, m_mapping_size, MADV_WILLNEED);
+
+    const uint32_t* header = (const uint32_t*)m_mapping;
+
+    if (map_uint32(header[0]) != magic) {
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::IDX_File",
+            std::format("Mismatched magic number in the header of '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+
+    // The lowest byte of the magic number is the number of dimensions
+    m_num_dimensions = magic & 0xFF;
+    if (m_num_dimensions == 0 || m_num_dimensions > IDX_FILE_MAX_DIMENSIONS) {
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::IDX_File",
+            std::format("Unsupported number of dimensions {}", m_num_dimensions));
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t header_size = (m_num_dimensions + 1) * sizeof(uint32_t);
+    if (m_mapping_size < header_size) {
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::IDX_File",
+            std::format("Unable to read headers from '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < m_num_dimensions; ++i) {
+        m_dimensions[i] = (size_t)map_uint32(header[i + 1]);
+    }
+
+    m_payload = (const uint8_t*)m_mapping + header_size;
+
+    if (m_mapping_size - header_size < count() * item_size()) {
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::IDX_File",
+            std::format("'{}' is truncated: expected {} bytes of data but found {}", path,
+                count() * item_size(), m_mapping_size - header_size));
+        exit(EXIT_FAILURE);
+    }
+}
+
+IDX_File::~IDX_File() {
+
+    if (m_mapping != NULL) {
+        munmap(m_mapping, m_mapping_size);
+        m_mapping = NULL;
+    }
+}
+
+size_t IDX_File::dimension(size_t index) const {
+
+    if (index >= m_num_dimensions) {
+        Log::log_message(Log::Log_Priority::ERROR, "IDX_File::dimension",
+            std::format("Requested dimension {} but the file only has {}", index, m_num_dimensions));
+        exit(EXIT_FAILURE);
+    }
+    return m_dimensions[index];
+}
+
+size_t IDX_File::count(void) const {
+    return m_dimensions[0];
+}
+
+size_t IDX_File::item_size(void) const {
+
+    size_t result = 1;
+    for (size_t i = 1; i < m_num_dimensions; ++i) {
+        result *= m_dimensions[i];
+    }
+    return result;
+}
+
+const uint8_t* IDX_File::payload(void) const {
+    return m_payload;
+}
+
 float MNIST_Utils_NS::pixel_to_float(const uint8_t* pixel) {
 
     return (float)*pixel / 255.0f;
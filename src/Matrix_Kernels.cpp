@@ -0,0 +1,560 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * The SIMD variants are compiled with per-function target attributes rather than
+ * global -m flags, so the rest of the binary keeps the baseline instruction set
+ * and only runs these paths after CPUID says it is safe to.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Matrix_Kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MATRIX_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define MATRIX_KERNELS_X86 0
+#endif
+
+using Matrix_Kernels_NS::Instruction_Set;
+using Matrix_Kernels_NS::Kernel_Table;
+
+/* Scalar kernels, used as the portable fallback and for the tails of the SIMD loops */
+
+static void add_scalar_isa(const float* a, const float* b, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = a[i] + b[i]; }
+}
+
+static void subtract_scalar_isa(const float* a, const float* b, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = a[i] - b[i]; }
+}
+
+static void multiply_scalar_isa(const float* a, const float* b, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = a[i] * b[i]; }
+}
+
+static void scale_scalar_isa(const float* a, float value, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = a[i] * value; }
+}
+
+static void add_value_scalar_isa(const float* a, float value, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = a[i] + value; }
+}
+
+static void fill_scalar_isa(float* destination, float value, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = value; }
+}
+
+static void convert_u8_scalar_isa(const uint8_t* a, float divisor, float* destination, size_t elements) {
+    for (size_t i = 0; i < elements; ++i) { destination[i] = (float)a[i] / divisor; }
+}
+
+static void gemv_scalar_isa(const float* a, size_t rows, size_t cols, const float* x, const float* bias,
+    float* destination) {
+    for (size_t i = 0; i < rows; ++i) {
+        const float* row = a + (i * cols);
+        float total = 0;
+        for (size_t j = 0; j < cols; ++j) {
+            total += row[j] * x[j];
+        }
+        destination[i] = total + ((bias != NULL) ? bias[i] : 0);
+    }
+}
+
+static const Kernel_Table SCALAR_KERNELS = {
+    add_scalar_isa, subtract_scalar_isa, multiply_scalar_isa,
+    scale_scalar_isa, add_value_scalar_isa, fill_scalar_isa,
+    convert_u8_scalar_isa, gemv_scalar_isa,
+    Instruction_Set::SCALAR
+};
+
+#if MATRIX_KERNELS_X86
+
+/* SSE kernels, 4 floats per register */
+
+__attribute__((target("sse2")))
+static void add_sse(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 4 <= elements; i += 4) {
+        _mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    add_scalar_isa(a + i, b + i, destination + i, elements - i);
+}
+
+__attribute__((target("sse2")))
+static void subtract_sse(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 4 <= elements; i += 4) {
+        _mm_storeu_ps(destination + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    subtract_scalar_isa(a + i, b + i, destination + i, elements - i);
+}
+
+__attribute__((target("sse2")))
+static void multiply_sse(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 4 <= elements; i += 4) {
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    multiply_scalar_isa(a + i, b + i, destination + i, elements - i);
+}
+
+__attribute__((target("sse2")))
+static void scale_sse(const float* a, float value, float* destination, size_t elements) {
+    const __m128 v = _mm_set1_ps(value);
+    size_t i = 0;
+    for (; i + 4 <= elements; i += 4) {
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_loadu_ps(a + i), v));
+    }
+    scale_scalar_isa(a + i, value, destination + i, elements - i);
+}
+
+__attribute__((target("sse2")))
+static void add_value_sse(const float* a, float value, float* destination, size_t elements) {
+    const __m128 v = _mm_set1_ps(value);
+    size_t i = 0;
+    for (; i + 4 <= elements; i += 4) {
+        _mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(a + i), v));
+    }
+    add_value_scalar_isa(a + i, value, destination + i, elements - i);
+}
+
+__attribute__((target("sse2")))
+static void fill_sse(float* destination, float value, size_t elements) {
+    const __m128 v = _mm_set1_ps(value);
+    size_t i = 0;
+    for (; i + 4 <= elements; i += 4) {
+        _mm_storeu_ps(destination + i, v);
+    }
+    fill_scalar_isa(destination + i, value, elements - i);
+}
+
+__attribute__((target("sse2")))
+static void convert_u8_sse(const uint8_t* a, float divisor, float* destination, size_t elements) {
+    const __m128 v = _mm_set1_ps(divisor);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        // SSE2 has no zero extending load, so widen 8 -> 16 -> 32 bits by interleaving with zeros
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_ps(destination + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), v));
+        _mm_storeu_ps(destination + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), v));
+        _mm_storeu_ps(destination + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), v));
+        _mm_storeu_ps(destination + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), v));
+    }
+    convert_u8_scalar_isa(a + i, divisor, destination + i, elements - i);
+}
+
+__attribute__((target("sse2")))
+static inline float horizontal_sum_sse(__m128 v) {
+    __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+}
+
+__attribute__((target("sse2")))
+static void gemv_sse(const float* a, size_t rows, size_t cols, const float* x, const float* bias,
+    float* destination) {
+    size_t i = 0;
+    // Four rows at a time share each load of x and keep four independent sums in flight
+    for (; i + 4 <= rows; i += 4) {
+        const float* r0 = a + (i * cols);
+        const float* r1 = r0 + cols;
+        const float* r2 = r1 + cols;
+        const float* r3 = r2 + cols;
+        __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps(), s2 = _mm_setzero_ps(), s3 = _mm_setzero_ps();
+        size_t j = 0;
+        for (; j + 4 <= cols; j += 4) {
+            const __m128 v = _mm_loadu_ps(x + j);
+            s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(r0 + j), v));
+            s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(r1 + j), v));
+            s2 = _mm_add_ps(s2, _mm_mul_ps(_mm_loadu_ps(r2 + j), v));
+            s3 = _mm_add_ps(s3, _mm_mul_ps(_mm_loadu_ps(r3 + j), v));
+        }
+        float t0 = horizontal_sum_sse(s0), t1 = horizontal_sum_sse(s1);
+        float t2 = horizontal_sum_sse(s2), t3 = horizontal_sum_sse(s3);
+        for (; j < cols; ++j) {
+            t0 += r0[j] * x[j];
+            t1 += r1[j] * x[j];
+            t2 += r2[j] * x[j];
+            t3 += r3[j] * x[j];
+        }
+        destination[i] = t0 + ((bias != NULL) ? bias[i] : 0);
+        destination[i + 1] = t1 + ((bias != NULL) ? bias[i + 1] : 0);
+        destination[i + 2] = t2 + ((bias != NULL) ? bias[i + 2] : 0);
+        destination[i + 3] = t3 + ((bias != NULL) ? bias[i + 3] : 0);
+    }
+    gemv_scalar_isa(a + (i * cols), rows - i, cols, x, (bias != NULL) ? bias + i : NULL, destination + i);
+}
+
+static const Kernel_Table SSE_KERNELS = {
+    add_sse, subtract_sse, multiply_sse,
+    scale_sse, add_value_sse, fill_sse,
+    convert_u8_sse, gemv_sse,
+    Instruction_Set::SSE
+};
+
+/* AVX2 kernels, 8 floats per register. Unrolled by two to keep both load ports busy */
+
+__attribute__((target("avx2")))
+static void add_avx2(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        __m256 x0 = _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 x1 = _mm256_add_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        _mm256_storeu_ps(destination + i, x0);
+        _mm256_storeu_ps(destination + i + 8, x1);
+    }
+    for (; i + 8 <= elements; i += 8) {
+        _mm256_storeu_ps(destination + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    add_scalar_isa(a + i, b + i, destination + i, elements - i);
+}
+
+__attribute__((target("avx2")))
+static void subtract_avx2(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        __m256 x0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 x1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        _mm256_storeu_ps(destination + i, x0);
+        _mm256_storeu_ps(destination + i + 8, x1);
+    }
+    for (; i + 8 <= elements; i += 8) {
+        _mm256_storeu_ps(destination + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    subtract_scalar_isa(a + i, b + i, destination + i, elements - i);
+}
+
+__attribute__((target("avx2")))
+static void multiply_avx2(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        __m256 x0 = _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 x1 = _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        _mm256_storeu_ps(destination + i, x0);
+        _mm256_storeu_ps(destination + i + 8, x1);
+    }
+    for (; i + 8 <= elements; i += 8) {
+        _mm256_storeu_ps(destination + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    multiply_scalar_isa(a + i, b + i, destination + i, elements - i);
+}
+
+__attribute__((target("avx2")))
+static void scale_avx2(const float* a, float value, float* destination, size_t elements) {
+    const __m256 v = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= elements; i += 8) {
+        _mm256_storeu_ps(destination + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), v));
+    }
+    scale_scalar_isa(a + i, value, destination + i, elements - i);
+}
+
+__attribute__((target("avx2")))
+static void add_value_avx2(const float* a, float value, float* destination, size_t elements) {
+    const __m256 v = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= elements; i += 8) {
+        _mm256_storeu_ps(destination + i, _mm256_add_ps(_mm256_loadu_ps(a + i), v));
+    }
+    add_value_scalar_isa(a + i, value, destination + i, elements - i);
+}
+
+__attribute__((target("avx2")))
+static void fill_avx2(float* destination, float value, size_t elements) {
+    const __m256 v = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= elements; i += 8) {
+        _mm256_storeu_ps(destination + i, v);
+    }
+    fill_scalar_isa(destination + i, value, elements - i);
+}
+
+__attribute__((target("avx2")))
+static void convert_u8_avx2(const uint8_t* a, float divisor, float* destination, size_t elements) {
+    const __m256 v = _mm256_set1_ps(divisor);
+    size_t i = 0;
+    for (; i + 8 <= elements; i += 8) {
+        __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(a + i))));
+        _mm256_storeu_ps(destination + i, _mm256_div_ps(f, v));
+    }
+    convert_u8_scalar_isa(a + i, divisor, destination + i, elements - i);
+}
+
+__attribute__((target("avx2")))
+static inline float horizontal_sum_avx2(__m256 v) {
+    return horizontal_sum_sse(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+__attribute__((target("avx2")))
+static void gemv_avx2(const float* a, size_t rows, size_t cols, const float* x, const float* bias,
+    float* destination) {
+    size_t i = 0;
+    // Four rows at a time share each load of x and keep four independent sums in flight
+    for (; i + 4 <= rows; i += 4) {
+        const float* r0 = a + (i * cols);
+        const float* r1 = r0 + cols;
+        const float* r2 = r1 + cols;
+        const float* r3 = r2 + cols;
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+        size_t j = 0;
+        for (; j + 8 <= cols; j += 8) {
+            const __m256 v = _mm256_loadu_ps(x + j);
+            s0 = _mm256_add_ps(s0, _mm256_mul_ps(_mm256_loadu_ps(r0 + j), v));
+            s1 = _mm256_add_ps(s1, _mm256_mul_ps(_mm256_loadu_ps(r1 + j), v));
+            s2 = _mm256_add_ps(s2, _mm256_mul_ps(_mm256_loadu_ps(r2 + j), v));
+            s3 = _mm256_add_ps(s3, _mm256_mul_ps(_mm256_loadu_ps(r3 + j), v));
+        }
+        float t0 = horizontal_sum_avx2(s0), t1 = horizontal_sum_avx2(s1);
+        float t2 = horizontal_sum_avx2(s2), t3 = horizontal_sum_avx2(s3);
+        for (; j < cols; ++j) {
+            t0 += r0[j] * x[j];
+            t1 += r1[j] * x[j];
+            t2 += r2[j] * x[j];
+            t3 += r3[j] * x[j];
+        }
+        destination[i] = t0 + ((bias != NULL) ? bias[i] : 0);
+        destination[i + 1] = t1 + ((bias != NULL) ? bias[i + 1] : 0);
+        destination[i + 2] = t2 + ((bias != NULL) ? bias[i + 2] : 0);
+        destination[i + 3] = t3 + ((bias != NULL) ? bias[i + 3] : 0);
+    }
+    gemv_scalar_isa(a + (i * cols), rows - i, cols, x, (bias != NULL) ? bias + i : NULL, destination + i);
+}
+
+static const Kernel_Table AVX2_KERNELS = {
+    add_avx2, subtract_avx2, multiply_avx2,
+    scale_avx2, add_value_avx2, fill_avx2,
+    convert_u8_avx2, gemv_avx2,
+    Instruction_Set::AVX2
+};
+
+/* AVX-512 kernels, 16 floats per register. The tail is handled with a masked load / store */
+
+__attribute__((target("avx512f")))
+static inline __mmask16 tail_mask(size_t remaining) {
+    return (__mmask16)((1u << remaining) - 1u);
+}
+
+__attribute__((target("avx512f")))
+static void add_avx512(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        _mm512_storeu_ps(destination + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    }
+    if (i < elements) {
+        __mmask16 mask = tail_mask(elements - i);
+        _mm512_mask_storeu_ps(destination + i, mask, _mm512_add_ps(
+            _mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void subtract_avx512(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        _mm512_storeu_ps(destination + i, _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    }
+    if (i < elements) {
+        __mmask16 mask = tail_mask(elements - i);
+        _mm512_mask_storeu_ps(destination + i, mask, _mm512_sub_ps(
+            _mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void multiply_avx512(const float* a, const float* b, float* destination, size_t elements) {
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        _mm512_storeu_ps(destination + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    }
+    if (i < elements) {
+        __mmask16 mask = tail_mask(elements - i);
+        _mm512_mask_storeu_ps(destination + i, mask, _mm512_mul_ps(
+            _mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void scale_avx512(const float* a, float value, float* destination, size_t elements) {
+    const __m512 v = _mm512_set1_ps(value);
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        _mm512_storeu_ps(destination + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), v));
+    }
+    if (i < elements) {
+        __mmask16 mask = tail_mask(elements - i);
+        _mm512_mask_storeu_ps(destination + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a + i), v));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void add_value_avx512(const float* a, float value, float* destination, size_t elements) {
+    const __m512 v = _mm512_set1_ps(value);
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        _mm512_storeu_ps(destination + i, _mm512_add_ps(_mm512_loadu_ps(a + i), v));
+    }
+    if (i < elements) {
+        __mmask16 mask = tail_mask(elements - i);
+        _mm512_mask_storeu_ps(destination + i, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, a + i), v));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void fill_avx512(float* destination, float value, size_t elements) {
+    const __m512 v = _mm512_set1_ps(value);
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        _mm512_storeu_ps(destination + i, v);
+    }
+    if (i < elements) {
+        _mm512_mask_storeu_ps(destination + i, tail_mask(elements - i), v);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void convert_u8_avx512(const uint8_t* a, float divisor, float* destination, size_t elements) {
+    const __m512 v = _mm512_set1_ps(divisor);
+    size_t i = 0;
+    for (; i + 16 <= elements; i += 16) {
+        __m512 f = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)(a + i))));
+        _mm512_storeu_ps(destination + i, _mm512_div_ps(f, v));
+    }
+    convert_u8_scalar_isa(a + i, divisor, destination + i, elements - i);
+}
+
+__attribute__((target("avx512f")))
+static void gemv_avx512(const float* a, size_t rows, size_t cols, const float* x, const float* bias,
+    float* destination) {
+    const size_t tail = cols % 16;
+    const size_t body = cols - tail;
+    const __mmask16 mask = tail_mask(tail);
+    size_t i = 0;
+    // Four rows at a time share each load of x and keep four independent FMA chains in flight.
+    // The ragged end of each row is a masked load rather than a scalar loop
+    for (; i + 4 <= rows; i += 4) {
+        const float* r0 = a + (i * cols);
+        const float* r1 = r0 + cols;
+        const float* r2 = r1 + cols;
+        const float* r3 = r2 + cols;
+        __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps(), s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+        for (size_t j = 0; j < body; j += 16) {
+            const __m512 v = _mm512_loadu_ps(x + j);
+            s0 = _mm512_fmadd_ps(_mm512_loadu_ps(r0 + j), v, s0);
+            s1 = _mm512_fmadd_ps(_mm512_loadu_ps(r1 + j), v, s1);
+            s2 = _mm512_fmadd_ps(_mm512_loadu_ps(r2 + j), v, s2);
+            s3 = _mm512_fmadd_ps(_mm512_loadu_ps(r3 + j), v, s3);
+        }
+        if (tail != 0) {
+            const __m512 v = _mm512_maskz_loadu_ps(mask, x + body);
+            s0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, r0 + body), v, s0);
+            s1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, r1 + body), v, s1);
+            s2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, r2 + body), v, s2);
+            s3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, r3 + body), v, s3);
+        }
+        destination[i] = _mm512_reduce_add_ps(s0) + ((bias != NULL) ? bias[i] : 0);
+        destination[i + 1] = _mm512_reduce_add_ps(s1) + ((bias != NULL) ? bias[i + 1] : 0);
+        destination[i + 2] = _mm512_reduce_add_ps(s2) + ((bias != NULL) ? bias[i + 2] : 0);
+        destination[i + 3] = _mm512_reduce_add_ps(s3) + ((bias != NULL) ? bias[i + 3] : 0);
+    }
+    for (; i < rows; ++i) {
+        const float* row = a + (i * cols);
+        __m512 s = _mm512_setzero_ps();
+        for (size_t j = 0; j < body; j += 16) {
+            s = _mm512_fmadd_ps(_mm512_loadu_ps(row + j), _mm512_loadu_ps(x + j), s);
+        }
+        if (tail != 0) {
+            s = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, row + body), _mm512_maskz_loadu_ps(mask, x + body), s);
+        }
+        destination[i] = _mm512_reduce_add_ps(s) + ((bias != NULL) ? bias[i] : 0);
+    }
+}
+
+static const Kernel_Table AVX512_KERNELS = {
+    add_avx512, subtract_avx512, multiply_avx512,
+    scale_avx512, add_value_avx512, fill_avx512,
+    convert_u8_avx512, gemv_avx512,
+    Instruction_Set::AVX512
+};
+
+#endif
+
+/**
+ * Get the kernel table built for an instruction set
+ * @param instruction_set The Instruction_Set to look up
+ * @returns Returns a pointer to the matching Kernel_Table
+ */
+static const Kernel_Table* table_for(Instruction_Set instruction_set) {
+
+#if MATRIX_KERNELS_X86
+    if (instruction_set == Instruction_Set::AVX512) { return &AVX512_KERNELS; }
+    if (instruction_set == Instruction_Set::AVX2) { return &AVX2_KERNELS; }
+    if (instruction_set == Instruction_Set::SSE) { return &SSE_KERNELS; }
+#else
+    (void)instruction_set;
+#endif
+    return &SCALAR_KERNELS;
+}
+
+/* The scalar table is constant initialized, so any Matrix operation that runs during
+ * static initialization of another translation unit still has valid kernels. The
+ * selector below then upgrades to the best table for this CPU at startup */
+static const Kernel_Table* active_kernels = &SCALAR_KERNELS;
+
+static struct Kernel_Selector {
+    Kernel_Selector() {
+        active_kernels = table_for(Matrix_Kernels_NS::detect_instruction_set());
+    }
+} kernel_selector;
+
+const Kernel_Table& Matrix_Kernels_NS::kernels(void) {
+
+    return *active_kernels;
+}
+
+Instruction_Set Matrix_Kernels_NS::detect_instruction_set(void) {
+
+#if MATRIX_KERNELS_X86
+    __builtin_cpu_init();
+
+    // __builtin_cpu_supports also checks XCR0, so these are only true if the OS saves the wider registers
+    if (__builtin_cpu_supports("avx512f")) { return Instruction_Set::AVX512; }
+    if (__builtin_cpu_supports("avx2")) { return Instruction_Set::AVX2; }
+    if (__builtin_cpu_supports("sse2")) { return Instruction_Set::SSE; }
+#endif
+    return Instruction_Set::SCALAR;
+}
+
+Instruction_Set Matrix_Kernels_NS::select_instruction_set(Instruction_Set instruction_set) {
+
+    Instruction_Set detected = detect_instruction_set();
+
+    if (instruction_set > detected) { instruction_set = detected; }
+
+    active_kernels = table_for(instruction_set);
+    return active_kernels->instruction_set;
+}
+
+const char* Matrix_Kernels_NS::instruction_set_name(Instruction_Set instruction_set) {
+
+    if (instruction_set == Instruction_Set::AVX512) { return "AVX-512"; }
+    if (instruction_set == Instruction_Set::AVX2) { return "AVX2"; }
+    if (instruction_set == Instruction_Set::SSE) { return "SSE"; }
+    return "Scalar";
+}
@@ -0,0 +1,208 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Model_File.hpp"
+
+#if defined(__x86_64__)
+#define MODEL_FILE_X86 1
+#include <immintrin.h>
+#else
+#define MODEL_FILE_X86 0
+#endif
+
+/* Reflected CRC32C polynomial */
+#define MODEL_FILE_CRC32C_POLYNOMIAL 0x82F63B78
+
+/* Byte at a time table for the portable CRC32C */
+static constexpr auto CRC32C_TABLE = [] {
+    struct { uint32_t entries[256]; } table = {};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (size_t j = 0; j < 8; ++j) {
+            crc = (crc & 1) ? (crc >> 1) ^ MODEL_FILE_CRC32C_POLYNOMIAL : crc >> 1;
+        }
+        table.entries[i] = crc;
+    }
+    return table;
+}();
+
+static uint32_t crc32c_scalar(const uint8_t* data, size_t bytes, uint32_t crc) {
+
+    for (size_t i = 0; i < bytes; ++i) {
+        crc = CRC32C_TABLE.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if MODEL_FILE_X86
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(const uint8_t* data, size_t bytes, uint32_t crc) {
+
+    uint64_t current = crc;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(uint64_t));
+        current = _mm_crc32_u64(current, word);
+    }
+
+    crc = (uint32_t)current;
+    for (; i < bytes; ++i) {
+        crc = _mm_crc32_u8(crc, data[i]);
+    }
+    return crc;
+}
+#endif
+
+uint32_t Model_File_NS::crc32c(const void* data, size_t bytes, uint32_t crc) {
+
+    crc = ~crc;
+#if MODEL_FILE_X86
+    static const bool hardware = __builtin_cpu_supports("sse4.2");
+    if (hardware) {
+        return ~crc32c_sse42((const uint8_t*)data, bytes, crc);
+    }
+#endif
+    return ~crc32c_scalar((const uint8_t*)data, bytes, crc);
+}
+
+size_t Model_File_NS::dtype_size(uint32_t dtype) {
+
+    if (dtype == Tensor_Dtype::FP32) { return sizeof(float); }
+    if (dtype == Tensor_Dtype::FP16) { return sizeof(uint16_t); }
+    if (dtype == Tensor_Dtype::INT8) { return sizeof(int8_t); }
+    return 0;
+}
+
+const char* Model_File_NS::dtype_name(uint32_t dtype) {
+
+    if (dtype == Tensor_Dtype::FP32) { return "fp32"; }
+    if (dtype == Tensor_Dtype::FP16) { return "fp16"; }
+    if (dtype == Tensor_Dtype::INT8) { return "int8"; }
+    return "unknown";
+}
+
+float Model_File_NS::encode_tensor(const float* source, size_t elements, Tensor_Dtype dtype, void* destination) {
+
+    if (dtype == Tensor_Dtype::FP32) {
+        memcpy(destination, source, elements * sizeof(float));
+        return 1;
+    }
+
+    if (dtype == Tensor_Dtype::FP16) {
+        uint16_t* target = (uint16_t*)destination;
+        for (size_t i = 0; i < elements; ++i) {
+            target[i] = float_to_half(source[i]);
+        }
+        return 1;
+    }
+
+    // INT8: one symmetric scale for the whole tensor, chosen so the largest value maps to +-127
+    float largest = 0;
+    for (size_t i = 0; i < elements; ++i) {
+        largest = fmaxf(largest, fabsf(source[i]));
+    }
+    const float scale = (largest > 0) ? largest / MODEL_FILE_INT8_MAX : 1;
+
+    int8_t* target = (int8_t*)destination;
+    for (size_t i = 0; i < elements; ++i) {
+        float quantized = rintf(source[i] / scale);
+        quantized = fminf(fmaxf(quantized, -MODEL_FILE_INT8_MAX), MODEL_FILE_INT8_MAX);
+        target[i] = (int8_t)quantized;
+    }
+    return scale;
+}
+
+void Model_File_NS::decode_tensor(const void* source, size_t elements, Tensor_Dtype dtype, float scale,
+    float* destination) {
+
+    if (dtype == Tensor_Dtype::FP32) {
+        memcpy(destination, source, elements * sizeof(float));
+    }
+    else if (dtype == Tensor_Dtype::FP16) {
+        const uint16_t* values = (const uint16_t*)source;
+        for (size_t i = 0; i < elements; ++i) {
+            destination[i] = half_to_float(values[i]);
+        }
+    }
+    else {
+        const int8_t* values = (const int8_t*)source;
+        for (size_t i = 0; i < elements; ++i) {
+            destination[i] = (float)values[i] * scale;
+        }
+    }
+}
+
+uint16_t Model_File_NS::float_to_half(float value) {
+
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    const uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    // NaN stays NaN (quiet), infinity stays infinity
+    if (magnitude >= 0x7F800000) {
+        return sign | 0x7C00 | ((magnitude > 0x7F800000) ? 0x0200 : 0);
+    }
+    // Too large for a half, round to infinity
+    if (magnitude >= 0x477FF000) {
+        return sign | 0x7C00;
+    }
+    // Normal halves: rebias the exponent and round the mantissa to nearest even
+    if (magnitude >= 0x38800000) {
+        const uint32_t rebiased = magnitude - 0x38000000;
+        const uint32_t rounded = rebiased + 0x0FFF + ((rebiased >> 13) & 1);
+        return sign | (uint16_t)(rounded >> 13);
+    }
+    // Subnormal halves (or zero): shift the mantissa, with its implicit bit, into place
+    if (magnitude >= 0x33000000) {
+        const uint32_t shift = 126 - (magnitude >> 23);
+        const uint32_t mantissa = (magnitude & 0x007FFFFF) | 0x00800000;
+        const uint32_t halfway = 1u << (shift - 1);
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t result = mantissa >> shift;
+        if (remainder > halfway || (remainder == halfway && (result & 1))) {
+            ++result;
+        }
+        return sign | (uint16_t)result;
+    }
+    return sign;
+}
+
+float Model_File_NS::half_to_float(uint16_t value) {
+
+    const uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x03FF;
+
+    if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+    }
+    if (exponent != 0) {
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+    if (mantissa == 0) {
+        return std::bit_cast<float>(sign);
+    }
+
+    // Subnormal half: normalize it, since every half subnormal is a normal float
+    uint32_t float_exponent = 113;
+    while ((mantissa & 0x0400) == 0) {
+        mantissa <<= 1;
+        --float_exponent;
+    }
+    return std::bit_cast<float>(sign | (float_exponent << 23) | ((mantissa & 0x03FF) << 13));
+}
@@ -8,7 +8,7 @@
  *                                                                                                               
  * Project: Basic Neural Network in C++
  * @author : Samuel Andersen
- * @version: 2025-07-22
+ * @version: 2026-10-17
  *
  * General Notes:
  *
@@ -22,18 +22,28 @@ using Neural_Network_NS::Cross_Entropy_Cost;
 
 float Quadratic_Cost::cost(const Matrix& output, const Matrix& expected) {
 
-    Matrix error = Matrix(output.rows(), output.cols());
-    // Subtract the output from the expected value, storing in error
-    expected.subtract(output, error);
-    // Square the difference
-    error.apply_second_o(pow, 2);
-    // Get the sum of distances and take square root
-    float distance = sqrtf(error.sum());
-    // Return 1/2 * (distance ^ 2)
-    return 0.5f * pow(distance, 2);
+    if (output.rows() != expected.rows() || output.cols() != expected.cols()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Quadratic_Cost::cost",
+            "Expected Matrix does not match output Matrix.");
+        exit(EXIT_FAILURE);
+    }
+
+    const float* outputs = output.data();
+    const float* labels = expected.data();
+    const size_t elements = output.rows() * output.cols();
+
+    // Sum the squared differences directly rather than building an error Matrix
+    float total = 0;
+    for (size_t i = 0; i < elements; ++i) {
+        const float difference = labels[i] - outputs[i];
+        total += difference * difference;
+    }
+
+    // Return 1/2 * (distance ^ 2), where distance ^ 2 is the sum of the squared differences
+    return 0.5f * total;
 }
 
-void Quadratic_Cost::delta(const Matrix& z, const Matrix& output, const Matrix& label, Matrix& destination) {
+void Quadratic_Cost::delta(const Matrix& output, const Matrix& label, Matrix& destination) {
 
     if (destination.rows() != output.rows() || destination.cols() != output.cols()) {
         Log::log_message(Log::Log_Priority::ERROR, "Quadratic_Cost::delta",
@@ -41,27 +51,48 @@ void Quadratic_Cost::delta(const Matrix& z, const Matrix& output, const Matrix&
         exit(EXIT_FAILURE);
     }
 
-    // Subtract the output from the label, storing in destination
-    label.subtract(output, destination);
+    const float* outputs = output.data();
+    const float* labels = label.data();
+    float* result = destination.data();
+    const size_t elements = output.rows() * output.cols();
 
-    // Create a Matrix to calculate the sigmoid prime
-    Matrix sp = Matrix(output.rows(), output.cols());
-    sigmoid_prime(z, sp);
-
-    // Multiply the difference between (label - output) * sigmoid_prime
-    destination.multiply_o(sp);
+    // (label - output) * sigmoid_prime, with sigmoid_prime taken from the output as s * (1 - s)
+    for (size_t i = 0; i < elements; ++i) {
+        result[i] = (labels[i] - outputs[i]) * outputs[i] * (1.0f - outputs[i]);
+    }
 }
 
 float Cross_Entropy_Cost::cost(const Matrix& output, const Matrix& expected) {
 
-    Matrix output_log = Matrix(output.rows(), output.cols());
-    output.apply(log10, output_log);
-    output_log.multiply_o(expected);
+    if (output.rows() != expected.rows() || output.cols() != expected.cols()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Cross_Entropy_Cost::cost",
+            "Expected Matrix does not match output Matrix.");
+        exit(EXIT_FAILURE);
+    }
+
+    const float* outputs = output.data();
+    const float* labels = expected.data();
+    const size_t elements = output.rows() * output.cols();
+
+    // Take log10 of the outputs a chunk at a time on the stack so this never allocates
+    float output_log[NEURAL_NETWORK_COST_CHUNK_SIZE];
+    float total = 0;
+
+    for (size_t i = 0; i < elements; i += NEURAL_NETWORK_COST_CHUNK_SIZE) {
+        const size_t chunk = (elements - i < NEURAL_NETWORK_COST_CHUNK_SIZE) ?
+            elements - i : NEURAL_NETWORK_COST_CHUNK_SIZE;
 
-    return (-1.0f) * output_log.sum();
+        Fast_Math_NS::log10(outputs + i, output_log, chunk);
+
+        for (size_t j = 0; j < chunk; ++j) {
+            total += labels[i + j] * output_log[j];
+        }
+    }
+
+    return (-1.0f) * total;
 }
 
-void Cross_Entropy_Cost::delta(const Matrix& z, const Matrix& output, const Matrix& label, Matrix& destination) {
+void Cross_Entropy_Cost::delta(const Matrix& output, const Matrix& label, Matrix& destination) {
 
     if (destination.rows() != output.rows() || destination.cols() != output.cols()) {
         Log::log_message(Log::Log_Priority::ERROR, "Cross_Entropy_Cost::delta",
@@ -73,46 +104,296 @@ void Cross_Entropy_Cost::delta(const Matrix& z, const Matrix& output, const Matr
     label.subtract(output, destination);
 }
 
-void Neural_Network::training_inference(const Matrix& input) {
+/**
+ * Multiply by the network's input, which is either float or a narrower type that the GEMM
+ * converts and scales while packing it
+ * @param left Left hand side of the product
+ * @param input The input Matrix
+ * @param input_scale Factor applied to a narrow input
+ * @param transpose_input True to multiply by the transpose of input
+ * @param destination Destination Matrix
+ */
+template <typename Input_Type>
+static void input_dot(const Matrix& left, const Matrix_NS::Matrix<Input_Type>& input, float input_scale,
+    bool transpose_input, Matrix& destination) {
+
+    if constexpr (std::is_same_v<Input_Type, float>) {
+        (void)input_scale;
+        if (transpose_input) { left.dot_nt(input, destination); }
+        else { left.dot(input, destination); }
+    }
+    else {
+        if (transpose_input) { left.dot_nt_scaled(input, input_scale, destination); }
+        else { left.dot_scaled(input, input_scale, destination); }
+    }
+}
 
-    // Copy the the inputs to the first layer's outputs
-    m_layers[0]->write_matrix(input, Layer_Type::OUTPUTS);
+template <typename Input_Type>
+void Neural_Network::training_inference(const Matrix_NS::Matrix<Input_Type>& input, Neural_Network_Workspace& workspace,
+    float input_scale) const {
 
-    // Begin feed-forward
+    // Begin feed-forward, storing the activations of each layer in the workspace. Backpropagation
+    // takes the sigmoid derivative from these, so z itself is never kept
     for (size_t i = 1; i < m_num_layers; ++i) {
-        // Special processing for the first hidden layer
+        Matrix& z = workspace.get(Workspace_Type::OUTPUTS, i);
+
+        // Dot product of this layer's weights by the previous layer's output. The first hidden
+        // layer reads the input directly
         if (i == 1) {
-            Matrix hidden_inputs = Matrix(m_layers[i]->get_const(Layer_Type::WEIGHTS).rows(),
-                input.cols());
+            input_dot(m_layers[i]->get_const(Layer_Type::WEIGHTS), input, input_scale, false, z);
+        }
+        else {
+            m_layers[i]->get_const(Layer_Type::WEIGHTS).dot(workspace.get_const(Workspace_Type::OUTPUTS, i - 1), z);
+        }
+
+        // Add the bias to every column and apply the activation function in place
+        bias_sigmoid(z, m_layers[i]->get_const(Layer_Type::BIASES), z);
+    }
+}
+
+template <typename Input_Type>
+float Neural_Network::compute_gradients(const Matrix_NS::Matrix<Input_Type>& inputs, const Matrix& labels,
+    Neural_Network_Workspace& workspace, float input_scale, bool input_gradient) const {
+
+    // Track loss across the batch
+    float total_loss = 0;
+
+    // Run inference on the Matrix of inputs and store their outputs in the workspace
+    training_inference(inputs, workspace, input_scale);
+
+    // Begin backpropagation
+    for (size_t i = m_num_layers - 1; i >= 1; --i) {
+
+        Matrix& error = workspace.get(Workspace_Type::ERRORS, i);
+
+        // Special processing for the output layer
+        if (i == m_num_layers - 1) {
+            const Matrix& outputs = workspace.get_const(Workspace_Type::OUTPUTS, i);
+
+            // Calculate the delta from the predicted output and the label
+            delta(outputs, labels, error);
 
-            // Dot product of the first hidden layer's weights by the image input
-            m_layers[i]->get_const(Layer_Type::WEIGHTS).dot(input, hidden_inputs);
+            // Get the loss for this training step
+            total_loss += cost(outputs, labels);
+        }
+        else {
+            // Process the remainder of the layers differently
 
-            // Add the bias before proceeding
-            hidden_inputs.add_o(m_layers[i]->get_const(Layer_Type::BIASES));
+            // Get the next layer's weights, which are used transposed
+            const Matrix& next_weights = m_layers[i + 1]->get_const(Layer_Type::WEIGHTS);
 
-            // Save the output before applying the activation function
-            m_layers[i]->write_matrix(hidden_inputs, Layer_Type::Z);
+            // Get the previous layer's error
+            const Matrix& prev_error = workspace.get_const(Workspace_Type::ERRORS, i + 1);
 
-            // The output of this layer is the input with the activation function applied
-            hidden_inputs.apply_o(sigmoid);
+            // Calculate the error for this layer as (next_weights^T * prev_error) * sigmoid_prime,
+            // with sigmoid_prime taken from this layer's cached outputs
+            next_weights.dot_tn(prev_error, error);
+            multiply_sigmoid_prime(workspace.get_const(Workspace_Type::OUTPUTS, i), error);
+        }
 
-            // Copy the activation outputs and store in the layer for later use
-            m_layers[i]->write_matrix(hidden_inputs, Layer_Type::OUTPUTS);
+        // Get the dot product of the errors and the transposed previous layer's outputs (the
+        // input for the first hidden layer), and sum the errors across the batch for the biases
+        if (i == 1) {
+            if (input_gradient) {
+                input_dot(error, inputs, input_scale, true, workspace.get(Workspace_Type::NABLA_W, i));
+            }
         }
         else {
-            Matrix hidden_inputs = Matrix(m_layers[i]->get_const(Layer_Type::WEIGHTS).rows(),
-                m_layers[i - 1]->get_const(Layer_Type::OUTPUTS).cols());
+            error.dot_nt(workspace.get_const(Workspace_Type::OUTPUTS, i - 1), workspace.get(Workspace_Type::NABLA_W, i));
+        }
+        error.dot(workspace.ones(), workspace.get(Workspace_Type::NABLA_B, i));
+    }
+
+    return total_loss;
+}
+
+void Neural_Network::apply_gradients(Neural_Network_Workspace& workspace, size_t batch_size, size_t dataset_size) {
 
-            // The next layer's inputs are the dot of this layer's weights by the previous layer's output
-            m_layers[i]->get_const(Layer_Type::WEIGHTS).dot(
-                m_layers[i - 1]->get_const(Layer_Type::OUTPUTS), hidden_inputs);
-                
-            hidden_inputs.add_o(m_layers[i]->get_const(Layer_Type::BIASES));
-            m_layers[i]->write_matrix(hidden_inputs, Layer_Type::Z);
-            hidden_inputs.apply_o(sigmoid);
-            m_layers[i]->write_matrix(hidden_inputs, Layer_Type::OUTPUTS);
+    for (size_t i = 1; i < m_num_layers; ++i) {
+
+        Matrix& nabla_w = workspace.get(Workspace_Type::NABLA_W, i);
+        Matrix& nabla_b = workspace.get(Workspace_Type::NABLA_B, i);
+
+        // Divide the sum of the deltas per layer by the batch size and multiply by the learning rate
+        nabla_w.scale_o(m_learning_rate / (float)batch_size);
+        nabla_b.scale_o(m_learning_rate / (float)batch_size);
+
+        // Add the processed changes to the original weights
+        m_layers[i]->get_mutable(Layer_Type::WEIGHTS).scale_o(1 - (m_learning_rate * (m_lambda / dataset_size)));
+        m_layers[i]->get_mutable(Layer_Type::WEIGHTS).add_o(nabla_w);
+
+        // Add the processed changes to the original biases
+        m_layers[i]->get_mutable(Layer_Type::BIASES).add_o(nabla_b);
+    }
+}
+
+void Neural_Network::apply_hogwild_gradients(const Matrix& input, Neural_Network_Workspace& workspace,
+    size_t batch_size, size_t dataset_size) {
+
+    const float step = m_learning_rate / (float)batch_size;
+    const size_t columns = input.cols();
+    const float* x = input.data();
+
+    // About 80% of MNIST pixels are zero, and so is every weight gradient column they feed.
+    // Collect the rows of the input that have anything in them
+    size_t* active = workspace.active_inputs();
+    size_t num_active = 0;
+
+    for (size_t c = 0; c < input.rows(); ++c) {
+        for (size_t k = 0; k < columns; ++k) {
+            if (x[(c * columns) + k] != 0) {
+                active[num_active++] = c;
+                break;
+            }
+        }
+    }
+
+    // First layer: weight (r, c) += step * sum over the batch of error(r, k) * input(c, k), for
+    // active c only
+    Matrix& first_weights = m_layers[1]->get_mutable(Layer_Type::WEIGHTS);
+    const float* error = workspace.get_const(Workspace_Type::ERRORS, 1).data();
+    float* weights = first_weights.data();
+
+    for (size_t r = 0; r < first_weights.rows(); ++r) {
+        float* row = weights + (r * first_weights.cols());
+        const float* error_row = error + (r * columns);
+
+        // A single column is the usual Hogwild! step, and the sum over the batch is one product
+        if (columns == 1) {
+            const float scaled_error = step * error_row[0];
+            for (size_t a = 0; a < num_active; ++a) {
+                row[active[a]] += scaled_error * x[active[a]];
+            }
+            continue;
+        }
+
+        for (size_t a = 0; a < num_active; ++a) {
+            const float* input_row = x + (active[a] * columns);
+            float gradient = 0;
+            for (size_t k = 0; k < columns; ++k) {
+                gradient += error_row[k] * input_row[k];
+            }
+            row[active[a]] += step * gradient;
+        }
+    }
+
+    // The remaining layers see sigmoid outputs, which are never zero, so their updates are dense.
+    // Each is still a single pass over the weights
+    for (size_t i = 2; i < m_num_layers; ++i) {
+        const float* nabla_w = workspace.get_const(Workspace_Type::NABLA_W, i).data();
+        Matrix& layer_weights = m_layers[i]->get_mutable(Layer_Type::WEIGHTS);
+        float* w = layer_weights.data();
+        const size_t elements = layer_weights.rows() * layer_weights.cols();
+
+        for (size_t j = 0; j < elements; ++j) {
+            w[j] += step * nabla_w[j];
+        }
+    }
+
+    for (size_t i = 1; i < m_num_layers; ++i) {
+        const float* nabla_b = workspace.get_const(Workspace_Type::NABLA_B, i).data();
+        Matrix& biases = m_layers[i]->get_mutable(Layer_Type::BIASES);
+        float* b = biases.data();
+
+        for (size_t j = 0; j < biases.rows(); ++j) {
+            b[j] += step * nabla_b[j];
+        }
+    }
+
+    // Decaying every step would rewrite every weight, including the ones the sparse update just
+    // skipped. Apply the decay of NEURAL_NETWORK_HOGWILD_DECAY_INTERVAL steps at once instead
+    if (workspace.count_step() % NEURAL_NETWORK_HOGWILD_DECAY_INTERVAL == 0 && m_lambda != 0) {
+        const float decay = powf(1 - (m_learning_rate * (m_lambda / dataset_size)),
+            (float)NEURAL_NETWORK_HOGWILD_DECAY_INTERVAL);
+
+        for (size_t i = 1; i < m_num_layers; ++i) {
+            m_layers[i]->get_mutable(Layer_Type::WEIGHTS).scale_o(decay);
+        }
+    }
+}
+
+bool Neural_Network::prepare_workspace(size_t batch_size) {
+
+    if (m_workspace != NULL) {
+        return m_workspace->resize(batch_size);
+    }
+
+    m_workspace = create_workspace(batch_size);
+    return true;
+}
+
+bool Neural_Network::prepare_workers(size_t num_workers, size_t batch_size) {
+
+    bool resized = false;
+
+    // Recreate the pool and workspaces if the number of workers changed
+    if (m_thread_pool == NULL || m_num_workers != num_workers) {
+        release_workers();
+
+        m_thread_pool = new Thread_Pool(num_workers);
+        m_worker_workspaces = (Neural_Network_Workspace**)calloc(num_workers, sizeof(Neural_Network_Workspace*));
+        m_worker_losses = (float*)calloc(num_workers, sizeof(float));
+
+        if (m_worker_workspaces == NULL || m_worker_losses == NULL) {
+            Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::prepare_workers",
+                "Unable to allocate memory for the worker workspaces");
+            exit(EXIT_FAILURE);
         }
+
+        m_num_workers = num_workers;
+        resized = true;
+    }
+
+    for (size_t i = 0; i < num_workers; ++i) {
+        // Each worker gets an even share of the batch, with the first (batch_size % num_workers) getting one extra
+        const size_t columns = (batch_size / num_workers) + ((i < batch_size % num_workers) ? 1 : 0);
+
+        if (m_worker_workspaces[i] == NULL) {
+            m_worker_workspaces[i] = create_workspace(columns);
+            resized = true;
+        }
+        else if (m_worker_workspaces[i]->resize(columns)) {
+            resized = true;
+        }
+    }
+
+    return resized;
+}
+
+void Neural_Network::release_workers(void) {
+
+    if (m_worker_workspaces != NULL) {
+        for (size_t i = 0; i < m_num_workers; ++i) {
+            if (m_worker_workspaces[i] != NULL) { delete m_worker_workspaces[i]; }
+        }
+        free(m_worker_workspaces);
+        m_worker_workspaces = NULL;
+    }
+
+    if (m_worker_losses != NULL) {
+        free(m_worker_losses);
+        m_worker_losses = NULL;
+    }
+
+    if (m_thread_pool != NULL) {
+        delete m_thread_pool;
+        m_thread_pool = NULL;
+    }
+
+    m_num_workers = 0;
+}
+
+void Neural_Network::require_trainable(const char* caller) const {
+
+    if (m_layers == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, caller, "m_layers is NULL. Cannot perform training");
+        exit(EXIT_FAILURE);
+    }
+
+    if (m_inference_only) {
+        Log::log_message(Log::Log_Priority::ERROR, caller,
+            "Neural_Network is inference-only. Load it with inference_only = false to train it");
+        exit(EXIT_FAILURE);
     }
 }
 
@@ -126,21 +407,273 @@ Neural_Network::Neural_Network(const std::vector<size_t>& layer_info, float lear
     }
 
     // Persist information about the Neural Network
-    m_num_layers = layer_info.size();
     m_learning_rate = learning_rate;
     m_lambda = lambda;
-    
-    if (cost_type == Cost_Function::CROSS_ENTROPY) {
-        cost = Cross_Entropy_Cost::cost;
-        delta = Cross_Entropy_Cost::delta;
+    set_cost_function(cost_type);
+
+    // Every layer after the input starts with random weights and biases
+    allocate_layers(layer_info, false);
+}
+
+/**
+ * Read a section marker from a model file
+ * @param model The model file
+ * @param expected The marker that should come next
+ * @returns Returns true if the next uint32_t in the file is the expected marker
+ */
+static bool read_marker(FILE* model, uint32_t expected) {
+
+    uint32_t marker = 0;
+    return fread(&marker, sizeof(uint32_t), 1, model) == 1 && marker == expected;
+}
+
+/**
+ * Read a block of floats from a model file straight into a Matrix, with a single read
+ * @param model The model file
+ * @param begin Marker expected before the block
+ * @param end Marker expected after the block
+ * @param destination Matrix whose storage the block is read into
+ * @returns Returns true if both markers matched and the whole block was read
+ */
+static bool read_block(FILE* model, uint32_t begin, uint32_t end, Matrix& destination) {
+
+    const size_t elements = destination.rows() * destination.cols();
+
+    return read_marker(model, begin) &&
+        fread(destination.data(), sizeof(float), elements, model) == elements &&
+        read_marker(model, end);
+}
+
+Neural_Network::Neural_Network(const char* path, bool inference_only) {
+
+    FILE* model = fopen(path, "rb");
+    if (model == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::Neural_Network",
+            std::format("Unable to open model '{}'", path));
+        exit(EXIT_FAILURE);
     }
 
-    m_cost_type = cost_type;
-    
+    // Both formats start with a magic number, which says which loader to use
+    uint32_t magic = 0;
+    const bool has_magic = fread(&magic, sizeof(uint32_t), 1, model) == 1;
+    fclose(model);
+
+    if (has_magic && magic == MODEL_FILE_MAGIC) {
+        load_v2(path);
+    }
+    else if (has_magic && magic == NN_HEADER_MAGIC) {
+        load_v1(path);
+    }
+    else {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::Neural_Network",
+            std::format("'{}' is not a model file", path));
+        exit(EXIT_FAILURE);
+    }
+
+    if (inference_only) {
+        to_inference_only();
+    }
+}
+
+void Neural_Network::load_v1(const char* path) {
+
+    FILE* model = fopen(path, "rb");
+    if (model == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v1",
+            std::format("Unable to open model '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+
+    struct stat model_info;
+    uint32_t cost_type = 0;
+
+    bool valid = fstat(fileno(model), &model_info) == 0 &&
+        read_marker(model, NN_HEADER_MAGIC) &&
+        fread(&m_learning_rate, sizeof(float), 1, model) == 1 &&
+        fread(&m_lambda, sizeof(float), 1, model) == 1 &&
+        fread(&cost_type, sizeof(uint32_t), 1, model) == 1 &&
+        fread(&m_num_layers, sizeof(size_t), 1, model) == 1;
+
+    const size_t file_size = valid ? (size_t)model_info.st_size : 0;
+
+    // Bound the layer count by the file size before trusting it for an allocation
+    if (!valid || m_num_layers == 0 || m_num_layers > file_size / sizeof(size_t) ||
+        cost_type > (uint32_t)Cost_Function::CROSS_ENTROPY) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v1",
+            std::format("'{}' does not have a valid model header", path));
+        fclose(model);
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<size_t> layer_info(m_num_layers);
+    valid = fread(layer_info.data(), sizeof(size_t), m_num_layers, model) == m_num_layers;
+
+    // The layer sizes fix the size of every block, so check the file is exactly that long
+    // before allocating anything
+    size_t expected_size = (4 * sizeof(uint32_t)) + ((m_num_layers + 1) * sizeof(size_t)) + (2 * sizeof(uint32_t));
+    for (size_t i = 0; valid && i < m_num_layers; ++i) {
+        if (layer_info[i] == 0 || layer_info[i] > file_size) {
+            valid = false;
+        }
+        else if (i > 0) {
+            expected_size += (4 * sizeof(uint32_t)) + (layer_info[i] * (layer_info[i - 1] + 1) * sizeof(float));
+        }
+    }
+
+    if (!valid || expected_size != file_size) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v1",
+            std::format("'{}' has invalid layer sizes or is not the size they imply", path));
+        fclose(model);
+        exit(EXIT_FAILURE);
+    }
+
+    set_cost_function((Cost_Function)cost_type);
+
+    // Zeroed weights and biases for the file to be read into
+    allocate_layers(layer_info, true);
+
+    valid = read_marker(model, NN_WEIGHTS_MAGIC);
+    for (size_t i = 1; valid && i < m_num_layers; ++i) {
+        valid = read_block(model, NN_WEIGHT_BEGIN, NN_WEIGHT_END, m_layers[i]->get_mutable(Layer_Type::WEIGHTS));
+    }
+
+    valid = valid && read_marker(model, NN_BIASES_MAGIC);
+    for (size_t i = 1; valid && i < m_num_layers; ++i) {
+        valid = read_block(model, NN_BIAS_BEGIN, NN_BIAS_END, m_layers[i]->get_mutable(Layer_Type::BIASES));
+    }
+
+    fclose(model);
+
+    if (!valid) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v1",
+            std::format("Mismatched section markers in '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+}
+
+void Neural_Network::load_v2(const char* path) {
+
+    if (!Model_File_NS::host_supported()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v2",
+            "v2 model files can only be read on little-endian hosts");
+        exit(EXIT_FAILURE);
+    }
+
+    int file = open(path, O_RDONLY);
+    struct stat model_info;
+
+    if (file < 0 || fstat(file, &model_info) != 0 || (size_t)model_info.st_size < sizeof(Model_File_Header)) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v2",
+            std::format("Unable to read model '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+
+    // A private writable mapping: inference processes share the page cache, and training a
+    // loaded model only copies the pages it updates
+    const size_t file_size = (size_t)model_info.st_size;
+    void* mapping = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    // The mapping holds its own reference to the file
+    close(file);
+
+    if (mapping == MAP_FAILED) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v2",
+            std::format("Unable to map model '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+
+    uint8_t* base = (uint8_t*)mapping;
+    Model_File_Header header;
+    memcpy(&header, base, sizeof(header));
+
+    const size_t toc_end = header.toc_offset + ((size_t)header.num_tensors * sizeof(Model_File_Tensor));
+
+    // Bound every count by the file size before using it for an allocation or an offset
+    bool valid = header.magic == MODEL_FILE_MAGIC &&
+        header.version == MODEL_FILE_VERSION &&
+        header.header_crc == Model_File_NS::crc32c(&header, offsetof(Model_File_Header, header_crc)) &&
+        header.file_size == file_size &&
+        header.num_layers != 0 && header.num_layers <= file_size / sizeof(uint32_t) &&
+        header.num_tensors == 2 * (header.num_layers - 1) &&
+        header.cost_function <= (uint32_t)Cost_Function::CROSS_ENTROPY &&
+        header.toc_offset >= sizeof(Model_File_Header) + ((size_t)header.num_layers * sizeof(uint32_t)) &&
+        header.toc_offset <= file_size && toc_end <= file_size &&
+        header.toc_crc == Model_File_NS::crc32c(base + sizeof(Model_File_Header), toc_end - sizeof(Model_File_Header));
+
+    std::vector<size_t> layer_info;
+    const Model_File_Tensor* tensors = (const Model_File_Tensor*)(base + header.toc_offset);
+
+    if (valid) {
+        const uint32_t* layer_sizes = (const uint32_t*)(base + sizeof(Model_File_Header));
+        for (size_t i = 0; i < header.num_layers; ++i) {
+            layer_info.push_back(layer_sizes[i]);
+            valid = valid && layer_sizes[i] != 0;
+        }
+    }
+
+    // The table of contents lists the weights then the biases of each layer after the input
+    for (size_t i = 0; valid && i < header.num_tensors; ++i) {
+        const Model_File_Tensor& tensor = tensors[i];
+        const size_t layer = (i / 2) + 1;
+        const size_t rows = layer_info[layer];
+        const size_t cols = (i % 2 == Model_File_NS::TENSOR_WEIGHTS) ? layer_info[layer - 1] : 1;
+
+        valid = tensor.layer == layer && tensor.kind == i % 2 &&
+            tensor.rows == rows && tensor.cols == cols &&
+            Model_File_NS::dtype_size(tensor.dtype) != 0 &&
+            tensor.size == rows * cols * Model_File_NS::dtype_size(tensor.dtype) &&
+            tensor.offset % MODEL_FILE_ALIGNMENT == 0 &&
+            tensor.offset >= toc_end && tensor.offset <= file_size && tensor.size <= file_size - tensor.offset &&
+            (!MODEL_FILE_VERIFY_TENSORS || tensor.crc == Model_File_NS::crc32c(base + tensor.offset, tensor.size));
+    }
+
+    if (!valid) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::load_v2",
+            std::format("'{}' is corrupt or not a valid v2 model", path));
+        munmap(mapping, file_size);
+        exit(EXIT_FAILURE);
+    }
+
+    m_num_layers = header.num_layers;
+    m_learning_rate = header.learning_rate;
+    m_lambda = header.lambda;
+    set_cost_function((Cost_Function)header.cost_function);
+    allocate_layers(layer_info, true);
+
+    // fp32 tensors are used in place, anything else is decoded into the layer's own storage
+    bool mapped = false;
+    for (size_t i = 0; i < header.num_tensors; ++i) {
+        const Model_File_Tensor& tensor = tensors[i];
+        const Layer_Type layer_type = (tensor.kind == Model_File_NS::TENSOR_WEIGHTS) ?
+            Layer_Type::WEIGHTS : Layer_Type::BIASES;
+        Neural_Network_Layer& layer = *(m_layers[tensor.layer]);
+
+        if (tensor.dtype == Model_File_NS::FP32) {
+            layer.attach_matrix((float*)(base + tensor.offset), layer_type);
+            mapped = true;
+        }
+        else {
+            Model_File_NS::decode_tensor(base + tensor.offset, (size_t)tensor.rows * tensor.cols,
+                (Model_File_NS::Tensor_Dtype)tensor.dtype, tensor.scale, layer.get_mutable(layer_type).data());
+        }
+    }
+
+    if (mapped) {
+        m_mapping = mapping;
+        m_mapping_size = file_size;
+    }
+    else {
+        munmap(mapping, file_size);
+    }
+}
+
+void Neural_Network::allocate_layers(const std::vector<size_t>& layer_info, bool import) {
+
+    m_num_layers = layer_info.size();
+
     // Allocate memory for the layers
     m_layers = (Neural_Network_Layer**)(calloc(m_num_layers, sizeof(Neural_Network_Layer*)));
     if (m_layers == NULL) {
-        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::Neural_Network",
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::allocate_layers",
             "Unable to allocate memory for layers. Exiting now...");
         exit(EXIT_FAILURE);
     }
@@ -149,9 +682,23 @@ Neural_Network::Neural_Network(const std::vector<size_t>& layer_info, float lear
     m_layers[0] = new Neural_Network_Layer(layer_info[0], 0, false, false);
 
     // For the remaining layers, iterate over layer_info, pulling the number of neurons and the previous
-    // layer's neurons too
+    // layer's neurons too. Imports get zeroed weights and biases, everything else random ones
     for (size_t i = 1; i < m_num_layers; ++i) {
-        m_layers[i] = new Neural_Network_Layer(layer_info[i], layer_info[i - 1], true, false);
+        m_layers[i] = new Neural_Network_Layer(layer_info[i], layer_info[i - 1], !import, import);
+    }
+}
+
+void Neural_Network::set_cost_function(Cost_Function cost_type) {
+
+    m_cost_type = cost_type;
+
+    if (cost_type == Cost_Function::CROSS_ENTROPY) {
+        cost = Cross_Entropy_Cost::cost;
+        delta = Cross_Entropy_Cost::delta;
+    }
+    else {
+        cost = Quadratic_Cost::cost;
+        delta = Quadratic_Cost::delta;
     }
 }
 
@@ -159,6 +706,13 @@ Neural_Network::Neural_Network() {}
 
 Neural_Network::~Neural_Network() {
 
+    if (m_workspace != NULL) {
+        delete m_workspace;
+        m_workspace = NULL;
+    }
+
+    release_workers();
+
     // Ensure m_layers actually exists before cleaning up
     if (m_layers != NULL) {
         for (size_t i = 0; i < m_num_layers; ++i) {
@@ -179,237 +733,182 @@ Neural_Network::~Neural_Network() {
         Log::log_message(Log::Log_Priority::WARNING, "Neural_Network::~Neural_Network",
             "m_layers is NULL. Not deallocating");
     }
-}
-
-float Neural_Network::train(const Matrix& input, const Matrix& label, size_t dataset_size) {
 
-    if (m_layers == NULL) {
-        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::train",
-            "m_layers is NULL. Cannot perform training");
-        exit(EXIT_FAILURE);
+    // The layers may have viewed the mapped model, so it goes last
+    if (m_mapping != NULL) {
+        munmap(m_mapping, m_mapping_size);
+        m_mapping = NULL;
     }
+}
 
-    // Run "inference" with the provided input
-    training_inference(input);
-
-    // Have somewhere to store the loss for a step
-    float total_loss = 0;
-
-    // Begin the backpropagation part of the training process
-    for (size_t i = m_num_layers - 1; i >= 1; --i) {
+float Neural_Network::train(const Matrix& input, const Matrix& label, size_t dataset_size) {
 
-        // Special processing for the output layer
-        if (i == m_num_layers - 1) {
-            // Calculate the delta from the predicted output and the label
-            Matrix error = Matrix(label.rows(), label.cols());
-            delta(m_layers[i]->get_const(Layer_Type::Z), m_layers[i]->get_const(Layer_Type::OUTPUTS),
-                label, error);
+    // A single example is a batch of one: the bias gradient (error * ones) is just the error
+    // and the learning rate is divided by 1, so both paths share the same workspace
+    return batch_train(input, label, dataset_size);
+}
 
-            // Persist the delta as error
-            m_layers[i]->write_matrix(error, Layer_Type::ERRORS);
+float Neural_Network::batch_train(const Matrix& inputs, const Matrix& labels, size_t dataset_size) {
 
-            // Get the loss for this training step
-            total_loss += cost(m_layers[i]->get_const(Layer_Type::OUTPUTS), label);
-        }
-        else {
-            // Process the remainder of the layers differently
+    return batch_step(inputs, labels, dataset_size, 1);
+}
 
-            // Calculate the sigmoid prime of z
-            const Matrix& z = m_layers[i]->get_const(Layer_Type::Z);
-            Matrix sp = Matrix(z.rows(), z.cols());
-            sigmoid_prime(z, sp);
+float Neural_Network::batch_train(const Byte_Matrix& inputs, const Matrix& labels, size_t dataset_size,
+    float input_scale) {
 
-            // Get the transpose of the next layer's weights
-            const Matrix& next_weights = m_layers[i + 1]->get_const(Layer_Type::WEIGHTS);
-            Matrix nw_t = Matrix(next_weights.rows(), next_weights.cols());
-            next_weights.copy_to(nw_t);
-            nw_t.transpose_self();
+    return batch_step(inputs, labels, dataset_size, input_scale);
+}
 
-            // Get the previous layer's error
-            const Matrix& prev_error = m_layers[i + 1]->get_const(Layer_Type::ERRORS);
+template <typename Input_Type>
+float Neural_Network::batch_step(const Matrix_NS::Matrix<Input_Type>& inputs, const Matrix& labels,
+    size_t dataset_size, float input_scale) {
 
-            // Calculate the error for this layer
-            Matrix error = Matrix(nw_t.rows(), prev_error.cols());
-            nw_t.dot(prev_error, error);
-            error.multiply_o(sp);
+    require_trainable("Neural_Network::train");
 
-            // Persist the new error
-            m_layers[i]->write_matrix(error, Layer_Type::ERRORS);
+    if (inputs.cols() != labels.cols()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::train",
+            "Number of columns in inputs and labels needs to match");
+        if (NEURAL_NETWORK_DEBUG) {
+            Log::log_message(Log::Log_Priority::DEBUG, "Neural_Network::train",
+                std::format("Inputs has {} columns, while labels has {}",
+                    inputs.cols(), labels.cols()));
         }
+        exit(EXIT_FAILURE);
+    }
 
-        // Get the transpose of previous layer's output
-        const Matrix& prev_output = m_layers[i - 1]->get_const(Layer_Type::OUTPUTS);
-        Matrix po_t = Matrix(prev_output.rows(), prev_output.cols());
-        prev_output.copy_to(po_t);
-        po_t.transpose_self();
-
-        const Matrix& error = m_layers[i]->get_const(Layer_Type::ERRORS);
+    // Have the batch size easily available
+    size_t batch_size = inputs.cols();
 
-        // Calculate the new weights
-        Matrix new_weights = Matrix(error.rows(), po_t.cols());
-        error.dot(po_t, new_weights);
-        m_layers[i]->write_matrix(new_weights, Layer_Type::NEW_WEIGHTS);
-    }
+    // Anything allocated after this point, other than growing the workspace, is a regression
+    const size_t allocations = Allocation_Counter_NS::allocations();
+    const bool workspace_resized = prepare_workspace(batch_size);
 
-    // Begin updating weights and biases
-    for (size_t i = 1; i < m_num_layers; ++i) {
-        // Get mutable references to the weights and biases to update them
-        Matrix& weights = m_layers[i]->get_mutable(Layer_Type::WEIGHTS);
-        Matrix& biases = m_layers[i]->get_mutable(Layer_Type::BIASES);
-        Matrix& nw = m_layers[i]->get_mutable(Layer_Type::NEW_WEIGHTS);
-        Matrix& error = m_layers[i]->get_mutable(Layer_Type::ERRORS);
+    float total_loss = compute_gradients(inputs, labels, *m_workspace, input_scale);
+    apply_gradients(*m_workspace, batch_size, dataset_size);
 
-        // Scale down the current weights by a factor of (1 - (learning_rate * lambda dataset_size))
-        weights.scale_o(1 - (m_learning_rate * (m_lambda / dataset_size)));
-        // Scale the new weights by the learning rate
-        nw.scale_o(m_learning_rate);
-        // Add the scaled new weights to the current weights
-        weights.add_o(nw);
+    if (ALLOCATION_COUNTER_ENABLED && !workspace_resized) {
+        const size_t step_allocations = Allocation_Counter_NS::allocations() - allocations;
 
-        // Scale the new biases by the learning rate
-        error.scale_o(m_learning_rate);
-        // Add the scaled new biases to the current biases
-        biases.add_o(error);
+        if (step_allocations != 0) {
+            Log::log_message(Log::Log_Priority::WARNING, "Neural_Network::batch_train",
+                std::format("Training step made {} heap allocations, expected 0", step_allocations));
+        }
     }
 
-    return total_loss;
+    return total_loss / batch_size;
 }
 
-float Neural_Network::batch_train(const Matrix& inputs, const Matrix& labels, size_t dataset_size) {
+float Neural_Network::parallel_batch_train(const Matrix& inputs, const Matrix& labels, size_t dataset_size,
+    size_t num_threads) {
 
-    if (m_layers == NULL) {
-        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::train",
-            "m_layers is NULL. Cannot perform training");
-        exit(EXIT_FAILURE);
-    }
+    require_trainable("Neural_Network::parallel_batch_train");
 
     if (inputs.cols() != labels.cols()) {
-        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::train",
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::parallel_batch_train",
             "Number of columns in inputs and labels needs to match");
         if (NEURAL_NETWORK_DEBUG) {
-            Log::log_message(Log::Log_Priority::DEBUG, "Neural_Network::train",
+            Log::log_message(Log::Log_Priority::DEBUG, "Neural_Network::parallel_batch_train",
                 std::format("Inputs has {} columns, while labels has {}",
                     inputs.cols(), labels.cols()));
         }
         exit(EXIT_FAILURE);
     }
 
-    // Setup our nablas, one for each layer except for the input layer
-    Matrix** nabla_w = (Matrix**)calloc(m_num_layers - 1, sizeof(Matrix*));
-    Matrix** nabla_b = (Matrix**)calloc(m_num_layers - 1, sizeof(Matrix*));
+    const size_t batch_size = inputs.cols();
 
-    if (nabla_w == NULL || nabla_b == NULL) {
-        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::train",
-            "Unable to allocate memory for nabla_w or nabla_b. Exiting");
-        exit(EXIT_FAILURE);
-    }
+    // Never split the batch finer than one column per worker
+    const size_t num_workers = (num_threads < batch_size) ? num_threads : batch_size;
 
-    // Initialize values for the nablas
-    for (size_t i = 0; i < m_num_layers - 1; ++i) {
-        nabla_w[i] = NULL;
-        nabla_b[i] = NULL;
+    if (num_workers <= 1) {
+        return batch_train(inputs, labels, dataset_size);
     }
 
-    // Track loss across the batch
-    float total_loss = 0;
-    // Have the batch size easily available
-    size_t batch_size = inputs.cols();
-
-    // Expand the bias Matrix instances to be of dimension [neurons x batch_size]
-    for (size_t i = 1; i < m_num_layers; ++i) {
-        m_layers[i]->expand_bias(batch_size);
-    }
+    const size_t allocations = Allocation_Counter_NS::allocations();
+    const bool workspace_resized = prepare_workers(num_workers, batch_size);
 
-    // Create a Matrix of ones to do a sum operation later
-    Matrix ones = Matrix(batch_size, 1);
-    ones.populate(1.0);
+    float* losses = m_worker_losses;
 
-    // Run inference on the Matrix of inputs and store their outputs in each layer
-    training_inference(inputs);
+    // Each worker copies out its slice of columns and runs forward and backward into its own workspace
+    auto compute = [&](size_t worker) {
+        Neural_Network_Workspace& workspace = *(m_worker_workspaces[worker]);
+        const size_t columns = workspace.batch_size();
+        const size_t start = (worker * (batch_size / num_workers)) +
+            ((worker < batch_size % num_workers) ? worker : batch_size % num_workers);
 
-    // Begin backpropagation
-    for (size_t i = m_num_layers - 1; i >= 1; --i) {
-        
-        // The error calculation should be exactly the same as the single training example above
-        // Special processing for the output layer
-        if (i == m_num_layers - 1) {
-            // Calculate the delta from the predicted output and the label
-            Matrix error = Matrix(labels.rows(), labels.cols());
-            delta(m_layers[i]->get_const(Layer_Type::Z), m_layers[i]->get_const(Layer_Type::OUTPUTS),
-                labels, error);
+        inputs.get_columns(start, columns, workspace.inputs());
+        labels.get_columns(start, columns, workspace.labels());
 
-            // Persist the delta as error
-            m_layers[i]->write_matrix(error, Layer_Type::ERRORS);
+        losses[worker] = compute_gradients(workspace.inputs(), workspace.labels(), workspace);
+    };
+    m_thread_pool->run(num_workers, compute);
 
-            // Get the loss for this training step
-            total_loss += cost(m_layers[i]->get_const(Layer_Type::OUTPUTS), labels);
-        }
-        else {
-            // Process the remainder of the layers differently
+    // Tree reduction: each round adds worker (i + stride) into worker i, halving the number of
+    // partial sums until worker 0 holds the gradient for the whole batch
+    for (size_t stride = 1; stride < num_workers; stride *= 2) {
+        auto reduce = [&](size_t pair) {
+            const size_t target = pair * 2 * stride;
+            const size_t source = target + stride;
 
-            // Calculate the sigmoid prime of z
-            const Matrix& z = m_layers[i]->get_const(Layer_Type::Z);
-            Matrix sp = Matrix(z.rows(), z.cols());
-            sigmoid_prime(z, sp);
+            if (source >= num_workers) { return; }
 
-            // Get the transpose of the next layer's weights
-            const Matrix& next_weights = m_layers[i + 1]->get_const(Layer_Type::WEIGHTS);
-            Matrix nw_t = Matrix(next_weights.rows(), next_weights.cols());
-            next_weights.copy_to(nw_t);
-            nw_t.transpose_self();
+            for (size_t i = 1; i < m_num_layers; ++i) {
+                m_worker_workspaces[target]->get(Workspace_Type::NABLA_W, i).add_o(
+                    m_worker_workspaces[source]->get_const(Workspace_Type::NABLA_W, i));
+                m_worker_workspaces[target]->get(Workspace_Type::NABLA_B, i).add_o(
+                    m_worker_workspaces[source]->get_const(Workspace_Type::NABLA_B, i));
+            }
+            losses[target] += losses[source];
+        };
+        m_thread_pool->run((num_workers + (2 * stride) - 1) / (2 * stride), reduce);
+    }
 
-            // Get the previous layer's error
-            const Matrix& prev_error = m_layers[i + 1]->get_const(Layer_Type::ERRORS);
+    // Single update with the reduced gradient, same as batch_train
+    apply_gradients(*(m_worker_workspaces[0]), batch_size, dataset_size);
 
-            // Calculate the error for this layer
-            Matrix error = Matrix(nw_t.rows(), prev_error.cols());
-            nw_t.dot(prev_error, error);
-            error.multiply_o(sp);
+    if (ALLOCATION_COUNTER_ENABLED && !workspace_resized) {
+        const size_t step_allocations = Allocation_Counter_NS::allocations() - allocations;
 
-            // Persist the new error
-            m_layers[i]->write_matrix(error, Layer_Type::ERRORS);
+        if (step_allocations != 0) {
+            Log::log_message(Log::Log_Priority::WARNING, "Neural_Network::parallel_batch_train",
+                std::format("Training step made {} heap allocations, expected 0", step_allocations));
         }
+    }
 
-        // Get the transpose of previous layer's output
-        const Matrix& prev_output = m_layers[i - 1]->get_const(Layer_Type::OUTPUTS);
-        Matrix po_t = Matrix(prev_output.rows(), prev_output.cols());
-        prev_output.copy_to(po_t);
-        po_t.transpose_self();
+    return losses[0] / batch_size;
+}
 
-        const Matrix& error = m_layers[i]->get_const(Layer_Type::ERRORS);
+float Neural_Network::hogwild_train(const Matrix& input, const Matrix& label, size_t dataset_size,
+    Neural_Network_Workspace& workspace) {
 
-        // Get the dot product of the transposed outputs and the errors * sigmoid
-        nabla_w[i - 1] = error.dot(po_t);
-        nabla_b[i - 1] = error.dot(ones);
+    require_trainable("Neural_Network::hogwild_train");
+
+    if (input.cols() != label.cols() || workspace.num_layers() != m_num_layers) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::hogwild_train",
+            "Input, label and workspace do not match this Neural_Network");
+        exit(EXIT_FAILURE);
     }
 
-    // Begin the final calculations for the new weights
+    workspace.resize(input.cols());
 
-    for (size_t i = 1; i < m_num_layers; ++i) {
+    // No locks on purpose: the gradient is computed from whatever the weights are right now and
+    // written straight back, racing with other threads. Hogwild! relies on each step writing
+    // only the weights its sample affects, so the first layer's gradient is never built densely
+    float total_loss = compute_gradients(input, label, workspace, 1, false);
+    apply_hogwild_gradients(input, workspace, input.cols(), dataset_size);
 
-        // Divide the sum of the deltas per layer by the batch size and multiply by the learning rate
-        nabla_w[i - 1]->scale_o(m_learning_rate / (float)batch_size);
-        nabla_b[i - 1]->scale_o(m_learning_rate / (float)batch_size);
-
-        // Add the processed changes to the original weights
-        m_layers[i]->get_mutable(Layer_Type::WEIGHTS).scale_o(1 - (m_learning_rate * (m_lambda / dataset_size)));
-        m_layers[i]->get_mutable(Layer_Type::WEIGHTS).add_o(*(nabla_w[i - 1]));
+    return total_loss / input.cols();
+}
 
-        // Clean up nabla_w
-        delete nabla_w[i - 1];
+Neural_Network_Workspace* Neural_Network::create_workspace(size_t batch_size) const {
 
-        // Convert the bias Matrix back to being one column wide
-        m_layers[i]->shrink_bias();
+    require_trainable("Neural_Network::create_workspace");
 
-        // Add the processed changes to the original biases
-        m_layers[i]->get_mutable(Layer_Type::BIASES).add_o(*(nabla_b[i - 1]));
-        delete nabla_b[i - 1];
+    std::vector<size_t> layer_info;
+    for (size_t i = 0; i < m_num_layers; ++i) {
+        layer_info.push_back(m_layers[i]->get_num_neurons());
     }
 
-    free(nabla_w);
-    free(nabla_b);
-
-    return total_loss / batch_size;
+    return new Neural_Network_Workspace(layer_info, batch_size);
 }
 
 Matrix* Neural_Network::inference(const Matrix& input) const {
@@ -427,59 +926,180 @@ Matrix* Neural_Network::inference(const Matrix& input) const {
 
 void Neural_Network::inference(const Matrix& input, Matrix& destination) const {
 
+    feed_forward(input, destination, 1, thread_context(input.cols()));
+}
+
+void Neural_Network::inference(const Byte_Matrix& input, Matrix& destination, float input_scale) const {
+
+    feed_forward(input, destination, input_scale, thread_context(input.cols()));
+}
+
+void Neural_Network::inference(const Matrix& input, Matrix& destination, Inference_Context& context) const {
+
+    feed_forward(input, destination, 1, context);
+}
+
+void Neural_Network::inference(const Byte_Matrix& input, Matrix& destination, Inference_Context& context,
+    float input_scale) const {
+
+    feed_forward(input, destination, input_scale, context);
+}
+
+Inference_Context* Neural_Network::create_inference_context(size_t max_batch_size) const {
+
+    if (m_layers == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::create_inference_context",
+            "m_layers is NULL. Cannot create an inference context");
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<size_t> layer_info;
+    for (size_t i = 0; i < m_num_layers; ++i) {
+        layer_info.push_back(m_layers[i]->get_num_neurons());
+    }
+
+    return new Inference_Context(layer_info, max_batch_size);
+}
+
+bool Neural_Network::context_matches(const Inference_Context& context) const {
+
+    if (context.num_layers() != m_num_layers) { return false; }
+
+    for (size_t i = 0; i < m_num_layers; ++i) {
+        if (context.layer_size(i) != m_layers[i]->get_num_neurons()) { return false; }
+    }
+
+    return true;
+}
+
+Inference_Context& Neural_Network::thread_context(size_t batch_size) const {
+
+    // One context per thread, shared by every network that thread runs. It is only rebuilt
+    // when the thread switches to a network with a different topology
+    static thread_local std::unique_ptr<Inference_Context> context;
+
+    if (context == nullptr || !context_matches(*context)) {
+        context.reset(create_inference_context(batch_size));
+    }
+    else {
+        context->resize(batch_size);
+    }
+
+    return *context;
+}
+
+template <typename Input_Type>
+void Neural_Network::feed_forward(const Matrix_NS::Matrix<Input_Type>& input, Matrix& destination,
+    float input_scale, Inference_Context& context) const {
+
     if (m_layers == NULL) {
         Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::inference",
             "m_layers is NULL. Cannot perform inference");
         exit(EXIT_FAILURE);
     }
 
-    if (m_layers[m_num_layers - 1]->get_num_neurons() != destination.rows()) {
+    if (m_layers[m_num_layers - 1]->get_num_neurons() != destination.rows() || input.cols() != destination.cols()) {
         Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::inference",
-            "Destination Matrix's number of rows does not match the number of neurons in output layer");
+            "Destination Matrix needs a row per output neuron and a column per input");
         exit(EXIT_FAILURE);
     }
 
-    // Use m_num_layers - 1 since the first layer's output is the actual input
-    Matrix** outputs = (Matrix**)calloc(m_num_layers - 1, sizeof(Matrix*));
+    // The GEMV path reads and converts input.rows() values without any further checks
+    if (input.rows() != m_layers[0]->get_num_neurons()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::inference",
+            std::format("Input has {} rows but the input layer has {} neurons", input.rows(),
+                m_layers[0]->get_num_neurons()));
+        exit(EXIT_FAILURE);
+    }
 
-    if (outputs == NULL) {
+    if (!context_matches(context)) {
         Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::inference",
-            "Unable to allocate memory for outputs");
+            "Inference_Context was created for a different topology");
         exit(EXIT_FAILURE);
     }
 
-    // Run feed-forward
+    context.resize(input.cols());
+
+    if (input.cols() == 1) {
+        feed_forward_single(input, destination, input_scale, context);
+        return;
+    }
+
+    // Run feed-forward, each layer reading the previous layer's activations from the context
     for (size_t i = 1; i < m_num_layers; ++i) {
+        Matrix& outputs = context.activations(i);
+
         if (i == 1) {
-            outputs[i - 1] = m_layers[i]->get_const(Layer_Type::WEIGHTS).dot(input);
+            input_dot(m_layers[i]->get_const(Layer_Type::WEIGHTS), input, input_scale, false, outputs);
         }
         else {
-            outputs[i - 1] = m_layers[i]->get_const(Layer_Type::WEIGHTS).dot(*(outputs[i - 2]));
+            m_layers[i]->get_const(Layer_Type::WEIGHTS).dot(context.activations(i - 1), outputs);
         }
 
-        // Add the biases to the input of the layer
-        outputs[i - 1]->add_o(m_layers[i]->get_const(Layer_Type::BIASES));
-
-        // Apply the activation function
-        outputs[i - 1]->apply_o(sigmoid);
+        // Add the bias to every column of the batch and apply the activation function in place
+        bias_sigmoid(outputs, m_layers[i]->get_const(Layer_Type::BIASES), outputs);
     }
 
     // Run softmax against each inference result (if more than one column)
-    softmax(*(outputs[m_num_layers - 2]), destination);
+    softmax(context.activations(m_num_layers - 1), destination);
+}
+
+template <typename Input_Type>
+void Neural_Network::feed_forward_single(const Matrix_NS::Matrix<Input_Type>& input, Matrix& destination,
+    float input_scale, Inference_Context& context) const {
+
+    const Matrix_Kernels_NS::Kernel_Table& kernel = Matrix_Kernels_NS::kernels();
+    const float* x = NULL;
+
+    // A single float column is already a contiguous vector. Bytes are converted into the context first
+    if constexpr (std::is_same_v<Input_Type, float>) {
+        (void)input_scale;
+        x = input.data();
+    }
+    else {
+        kernel.convert_u8(input.data(), 1.0f / input_scale, context.inputs().data(), input.rows());
+        x = context.inputs().data();
+    }
+
+    // One GEMV per layer with the bias folded into the kernel, then the activation in place
+    for (size_t i = 1; i < m_num_layers; ++i) {
+        const Matrix& weights = m_layers[i]->get_const(Layer_Type::WEIGHTS);
+        float* outputs = context.activations(i).data();
+
+        kernel.gemv(weights.data(), weights.rows(), weights.cols(), x,
+            m_layers[i]->get_const(Layer_Type::BIASES).data(), outputs);
+        Fast_Math_NS::sigmoid(outputs, outputs, weights.rows());
+
+        x = outputs;
+    }
 
-    // Clean up the allocated Matrix instances
-    for (size_t i = 0; i < m_num_layers - 1; ++i) {
-        delete outputs[i];
+    softmax(context.activations(m_num_layers - 1), destination);
+}
+
+size_t Neural_Network::get_num_layers(void) const {
+
+    return m_num_layers;
+}
+
+size_t Neural_Network::get_num_neurons(size_t layer) const {
+
+    if (m_layers == NULL || layer >= m_num_layers) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::get_num_neurons",
+            std::format("Layer {} does not exist", layer));
+        exit(EXIT_FAILURE);
     }
-    free(outputs);
+
+    return m_layers[layer]->get_num_neurons();
 }
 
-Neural_Network* Neural_Network::clone(void) {
+Neural_Network* Neural_Network::clone(void) const {
 
     Neural_Network* target = new Neural_Network();
     target->m_num_layers = m_num_layers;
     target->m_learning_rate = m_learning_rate;
     target->m_lambda = m_lambda;
+    target->m_inference_only = true;
+    target->set_cost_function(m_cost_type);
     target->m_layers = (Neural_Network_Layer**)calloc(m_num_layers, sizeof(Neural_Network_Layer*));
 
     if (target->m_layers == NULL) {
@@ -488,26 +1108,124 @@ Neural_Network* Neural_Network::clone(void) {
         exit(EXIT_FAILURE);
     }
 
+    // Only the weights and biases are copied, never the mapping or any training state
     for (size_t i = 0; i < m_num_layers; ++i) {
-        target->m_layers[i] = m_layers[i]->clone();
+        target->m_layers[i] = m_layers[i]->clone(true);
+    }
+
+    return target;
+}
+
+void Neural_Network::to_inference_only(void) {
+
+    if (m_workspace != NULL) {
+        delete m_workspace;
+        m_workspace = NULL;
     }
 
-    target->m_cost_type = m_cost_type;
+    release_workers();
 
-    if (m_cost_type == Cost_Function::CROSS_ENTROPY) {
-        target->cost = Cross_Entropy_Cost::cost;
-        target->delta = Cross_Entropy_Cost::delta;
+    for (size_t i = 0; m_layers != NULL && i < m_num_layers; ++i) {
+        m_layers[i]->to_inference_only();
     }
 
-    return target;
+    m_inference_only = true;
 }
 
-void Neural_Network::save(const char* path) const {
+bool Neural_Network::is_inference_only(void) const {
 
-    FILE* model = fopen(path, "w");
+    return m_inference_only;
+}
 
-    if (model == NULL) {
+void Neural_Network::save(const char* path, Model_File_NS::Tensor_Dtype dtype) const {
+
+    if (!Model_File_NS::host_supported()) {
         Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::save",
+            "v2 model files can only be written on little-endian hosts, use save_v1() instead");
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t num_tensors = 2 * (m_num_layers - 1);
+    const size_t toc_offset = sizeof(Model_File_Header) + (((m_num_layers * sizeof(uint32_t)) + 7) & ~(size_t)7);
+    const size_t toc_end = toc_offset + (num_tensors * sizeof(Model_File_Tensor));
+
+    // Lay the tensors out first, so the whole file can be built in memory and written at once
+    std::vector<Model_File_Tensor> tensors(num_tensors);
+    size_t file_size = Model_File_NS::align(toc_end);
+
+    for (size_t i = 0; i < num_tensors; ++i) {
+        const size_t layer = (i / 2) + 1;
+        const Matrix& values = m_layers[layer]->get_const((i % 2 == Model_File_NS::TENSOR_WEIGHTS) ?
+            Layer_Type::WEIGHTS : Layer_Type::BIASES);
+
+        memset(&tensors[i], 0, sizeof(Model_File_Tensor));
+        tensors[i].layer = (uint32_t)layer;
+        tensors[i].kind = (uint32_t)(i % 2);
+        // Biases are tiny and sensitive to rounding, so only the weights are stored narrower
+        tensors[i].dtype = (i % 2 == Model_File_NS::TENSOR_WEIGHTS) ? (uint32_t)dtype : (uint32_t)Model_File_NS::FP32;
+        tensors[i].rows = (uint32_t)values.rows();
+        tensors[i].cols = (uint32_t)values.cols();
+        tensors[i].offset = file_size;
+        tensors[i].size = values.rows() * values.cols() * Model_File_NS::dtype_size(tensors[i].dtype);
+
+        file_size = Model_File_NS::align(file_size + tensors[i].size);
+    }
+
+    // Zeroed, so the padding between sections is deterministic
+    uint8_t* buffer = (uint8_t*)calloc(file_size, 1);
+    if (buffer == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::save",
+            "Unable to allocate memory for the model file");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < num_tensors; ++i) {
+        const Matrix& values = m_layers[tensors[i].layer]->get_const(
+            (tensors[i].kind == Model_File_NS::TENSOR_WEIGHTS) ? Layer_Type::WEIGHTS : Layer_Type::BIASES);
+
+        tensors[i].scale = Model_File_NS::encode_tensor(values.data(), values.rows() * values.cols(),
+            (Model_File_NS::Tensor_Dtype)tensors[i].dtype, buffer + tensors[i].offset);
+        tensors[i].crc = Model_File_NS::crc32c(buffer + tensors[i].offset, tensors[i].size);
+    }
+
+    uint32_t* layer_sizes = (uint32_t*)(buffer + sizeof(Model_File_Header));
+    for (size_t i = 0; i < m_num_layers; ++i) {
+        layer_sizes[i] = (uint32_t)m_layers[i]->get_num_neurons();
+    }
+    memcpy(buffer + toc_offset, tensors.data(), num_tensors * sizeof(Model_File_Tensor));
+
+    Model_File_Header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MODEL_FILE_MAGIC;
+    header.version = MODEL_FILE_VERSION;
+    header.num_layers = (uint32_t)m_num_layers;
+    header.num_tensors = (uint32_t)num_tensors;
+    header.learning_rate = m_learning_rate;
+    header.lambda = m_lambda;
+    header.cost_function = (uint32_t)m_cost_type;
+    header.toc_offset = toc_offset;
+    header.file_size = file_size;
+    header.toc_crc = Model_File_NS::crc32c(buffer + sizeof(Model_File_Header), toc_end - sizeof(Model_File_Header));
+    header.header_crc = Model_File_NS::crc32c(&header, offsetof(Model_File_Header, header_crc));
+    memcpy(buffer, &header, sizeof(header));
+
+    FILE* model = fopen(path, "wb");
+    const bool written = model != NULL && fwrite(buffer, 1, file_size, model) == file_size;
+    free(buffer);
+
+    if (model == NULL || !written || fclose(model) != 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::save",
+            std::format("Unable to write the model to '{}'", path));
+        exit(EXIT_FAILURE);
+    }
+}
+
+void Neural_Network::save_v1(const char* path) const {
+
+    FILE* model = fopen(path, "wb");
+
+    if (model == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::save_v1",
             "Unable to open path to save Neural_Network");
         exit(EXIT_FAILURE);
     }
@@ -539,8 +1257,6 @@ void Neural_Network::save(const char* path) const {
 
     // Write the magic for the start of the weights section
     fwrite(&weights_magic, sizeof(uint32_t), 1, model);
-    // Set up a float to store the weights / biases as they are read
-    float current_value = 0;
 
     // Iterate over the layers, ignoring the input layer since it has no weights or biases
     for (size_t i = 1; i < m_num_layers; ++i) {
@@ -548,13 +1264,9 @@ void Neural_Network::save(const char* path) const {
         fwrite(&weights_begin, sizeof(uint32_t), 1, model);
         const Matrix& weights = m_layers[i]->get_const(Layer_Type::WEIGHTS);
 
-        for (size_t j = 0; j < weights.rows(); ++j) {
-            for (size_t k = 0; k < weights.cols(); ++k) {
+        // The Matrix is stored row-major, which is the order the file uses, so write it in one go
+        fwrite(weights.data(), sizeof(float), weights.rows() * weights.cols(), model);
 
-                current_value = weights.get(j, k);
-                fwrite(&current_value, sizeof(float), 1, model);
-            }
-        }
         // Signal the end of a weights Matrix
         fwrite(&weights_end, sizeof(uint32_t), 1, model);
     }
@@ -569,25 +1281,70 @@ void Neural_Network::save(const char* path) const {
     // Iterate over the layers, ignoring the input layer since it has no weights or biases
     for (size_t i = 1; i < m_num_layers; ++i) {
 
-        // Signal the beginning of a weights Matrix
+        // Signal the beginning of a bias Matrix
         fwrite(&bias_begin, sizeof(uint32_t), 1, model);
         const Matrix& biases = m_layers[i]->get_const(Layer_Type::BIASES);
 
-        for (size_t j = 0; j < biases.rows(); ++j) {
+        fwrite(biases.data(), sizeof(float), biases.rows(), model);
 
-            current_value = biases.get(j, 0);
-            fwrite(&current_value, sizeof(float), 1, model);
-        }
-        // Signal the end of a weights Matrix
+        // Signal the end of a bias Matrix
         fwrite(&bias_end, sizeof(uint32_t), 1, model);
     }
 
-    fclose(model);
+    if (ferror(model) || fclose(model) != 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::save_v1",
+            std::format("Unable to write the model to '{}'", path));
+        exit(EXIT_FAILURE);
+    }
 }
 
 float Neural_Network_NS::sigmoid(float z) {
 
-    return 1.0f / (1 + exp(-1 * z));
+    if (Fast_Math_NS::get_precision() == Fast_Math_NS::Math_Precision::FAST) {
+        return Fast_Math_NS::fast_sigmoid(z);
+    }
+
+    return 1.0f / (1.0f + expf(-z));
+}
+
+void Neural_Network_NS::sigmoid(const Matrix& target, Matrix& destination) {
+
+    if (target.rows() != destination.rows() || target.cols() != destination.cols()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::sigmoid",
+            "Target and destination sizes are different. Cannot proceed");
+        exit(EXIT_FAILURE);
+    }
+
+    Fast_Math_NS::sigmoid(target.data(), destination.data(), target.rows() * target.cols());
+}
+
+void Neural_Network_NS::bias_sigmoid(Matrix& z, const Matrix& bias, Matrix& destination) {
+
+    if (z.rows() != destination.rows() || z.cols() != destination.cols()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::bias_sigmoid",
+            "Target and destination sizes are different. Cannot proceed");
+        exit(EXIT_FAILURE);
+    }
+
+    if (bias.rows() != z.rows() || bias.cols() != 1) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::bias_sigmoid",
+            std::format("Bias of size {}x{} cannot be broadcast over {} rows", bias.rows(), bias.cols(), z.rows()));
+        exit(EXIT_FAILURE);
+    }
+
+    Fast_Math_NS::bias_sigmoid(z.data(), bias.data(), z.rows(), z.cols(), destination.data());
+}
+
+void Neural_Network_NS::multiply_sigmoid_prime(const Matrix& outputs, Matrix& destination) {
+
+    if (outputs.rows() != destination.rows() || outputs.cols() != destination.cols()) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network::multiply_sigmoid_prime",
+            "Outputs and destination sizes are different. Cannot proceed");
+        exit(EXIT_FAILURE);
+    }
+
+    Fast_Math_NS::multiply_sigmoid_prime(destination.data(), outputs.data(), destination.data(),
+        outputs.rows() * outputs.cols());
 }
 
 Matrix* Neural_Network_NS::softmax(const Matrix& target) {
@@ -605,20 +1362,35 @@ void Neural_Network_NS::softmax(const Matrix& target, Matrix& destination) {
         exit(EXIT_FAILURE);
     }
 
-    // Copy the contents of the target to the destination
-    target.copy_to(destination);
-    // Apply the exp function across all elements of destination
-    destination.apply_o(exp);
+    const size_t rows = target.rows();
+    const size_t cols = target.cols();
+    const float* source = target.data();
+    float* result = destination.data();
 
-    for (size_t i = 0; i < target.cols(); ++i) {
-        // Create a per-column total
+    // Shift each column by its maximum so exp can't overflow. This doesn't change the result
+    for (size_t i = 0; i < cols; ++i) {
+        float max = source[i];
+        for (size_t j = 1; j < rows; ++j) {
+            max = (source[(j * cols) + i] > max) ? source[(j * cols) + i] : max;
+        }
+        for (size_t j = 0; j < rows; ++j) {
+            result[(j * cols) + i] = source[(j * cols) + i] - max;
+        }
+    }
+
+    // Apply the exp function across all elements of destination in one pass
+    Fast_Math_NS::exp(result, result, rows * cols);
+
+    for (size_t i = 0; i < cols; ++i) {
+        // Create a per-column total from the exponentials we already have
         float total = 0;
-        for (size_t j = 0; j < target.rows(); ++j) {
-            total += exp(target.get(j, i));
+        for (size_t j = 0; j < rows; ++j) {
+            total += result[(j * cols) + i];
         }
         // Set the destination Matrix values to (current * 1/total)
-        for (size_t j = 0; j < target.rows(); ++j) {
-            destination.set(j, i, destination.get(j, i) * (1.0f / total));
+        const float inverse_total = 1.0f / total;
+        for (size_t j = 0; j < rows; ++j) {
+            result[(j * cols) + i] *= inverse_total;
         }
     }
 }
@@ -638,15 +1410,9 @@ void Neural_Network_NS::sigmoid_prime(const Matrix& target, Matrix& destination)
         exit(EXIT_FAILURE);
     }
     
-    // Calculate the sigmoid of the Matrix
-    Matrix t_sigmoid = Matrix(target.rows(), target.cols());
-    target.copy_to(t_sigmoid);
-    t_sigmoid.apply_o(sigmoid);
-
-    // Subtract the sigmoid from a Matrix of all ones
-    destination.populate(1.0);
-    destination.subtract_o(t_sigmoid);
+    // Calculate the sigmoid of the Matrix straight into the destination
+    sigmoid(target, destination);
 
     // Multiply the sigmoid by (1 - sigmoid)
-    destination.multiply_o(t_sigmoid);
+    destination.apply_o([](float s) { return s * (1.0f - s); });
 }
@@ -57,11 +57,17 @@ Neural_Network_Layer::Neural_Network_Layer(size_t num_neurons, size_t previous_l
     m_previous_layer_neurons = previous_layer_neurons;
 
     // Don't initialize any of the Matrix instances if this is the first (input) layer
-    // or if we are using this as an import
-    if (previous_layer_neurons == 0 || import) {
+    if (previous_layer_neurons == 0) {
         return; 
     }
 
+    // Imports get zeroed storage of the right shape, for the caller to copy or read into
+    if (import) {
+        m_weights = new Matrix(num_neurons, previous_layer_neurons);
+        m_biases = new Matrix(num_neurons, 1);
+        return;
+    }
+
     // Initialize the weights, biases, etc.
     m_weights = new Matrix(num_neurons, previous_layer_neurons);
 
@@ -85,6 +91,12 @@ Neural_Network_Layer::Neural_Network_Layer(size_t num_neurons, size_t previous_l
     }
 }
 
+Neural_Network_Layer::Neural_Network_Layer(size_t num_neurons, size_t previous_layer_neurons) {
+
+    m_num_neurons = num_neurons;
+    m_previous_layer_neurons = previous_layer_neurons;
+}
+
 Neural_Network_Layer::~Neural_Network_Layer() {
 
     if (m_weights != NULL) { delete m_weights; }
@@ -107,14 +119,23 @@ size_t Neural_Network_Layer::get_previous_layer_num_neurons(void) const {
 
 Neural_Network_Layer* Neural_Network_Layer::clone(void) const {
 
-    // Allocate a new Neural_Network_Layer using the same number of neurons
-    // Set previous_layer_neurons = 0, generate_biases = false, and import = true
-    // since we are going to just copy whatever elements are present here
-    Neural_Network_Layer* target = new Neural_Network_Layer(m_num_neurons, m_previous_layer_neurons, false, true);
+    return clone(m_inference_only);
+}
+
+Neural_Network_Layer* Neural_Network_Layer::clone(bool inference_only) const {
+
+    // Start from an empty layer of the same shape, so the only allocations are the copies
+    Neural_Network_Layer* target = new Neural_Network_Layer(m_num_neurons, m_previous_layer_neurons);
 
     // For each underlying Matrix, create a deep copy if it is not NULL
     if (m_weights != NULL) { target->m_weights = m_weights->clone(); }
     if (m_biases != NULL) { target->m_biases = m_biases->clone(); }
+
+    if (inference_only) {
+        target->m_inference_only = true;
+        return target;
+    }
+
     if (m_outputs != NULL) { target->m_outputs = m_outputs->clone(); }
     if (m_errors != NULL) { target->m_errors = m_errors->clone(); }
     if (m_new_weights != NULL) { target->m_new_weights = m_new_weights->clone(); }
@@ -141,6 +162,10 @@ void Neural_Network_Layer::clone(Neural_Network_Layer& destination) const {
     // Iterate through each Matrix, letting write_matrix handle size differences or NULL pointers
     if (m_weights != NULL) { destination.write_matrix(*m_weights, Layer_Type::WEIGHTS); }
     if (m_biases != NULL) { destination.write_matrix(*m_biases, Layer_Type::BIASES); }
+
+    // Inference-only destinations only take the weights and biases
+    if (destination.is_inference_only()) { return; }
+
     if (m_outputs != NULL) { destination.write_matrix(*m_outputs, Layer_Type::OUTPUTS); }
     if (m_errors != NULL) { destination.write_matrix(*m_errors, Layer_Type::ERRORS); }
     if (m_new_weights != NULL) { destination.write_matrix(*m_new_weights, Layer_Type::NEW_WEIGHTS); }
@@ -205,6 +230,12 @@ const Matrix& Neural_Network_Layer::get_const(Layer_Type layer_type) const {
 }
 
 void Neural_Network_Layer::write_matrix(const Matrix& target, Layer_Type layer_type) {
+
+    if (m_inference_only && layer_type != Layer_Type::WEIGHTS && layer_type != Layer_Type::BIASES) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Layer::write_matrix",
+            std::format("Layer is inference-only and cannot hold a Matrix of type {}", (int)layer_type));
+        exit(EXIT_FAILURE);
+    }
     
     if (layer_type == Layer_Type::WEIGHTS) {
         // Check to see if a Matrix is already allocated
@@ -306,39 +337,38 @@ void Neural_Network_Layer::write_matrix(const Matrix& target, Layer_Type layer_t
         "Invalid Layer_Type provided. Not doing anything");
 }
 
-void Neural_Network_Layer::expand_bias(size_t batch_size) {
+void Neural_Network_Layer::attach_matrix(float* data, Layer_Type layer_type) {
 
-    if (!exists(Layer_Type::BIASES)) {
-        Log::log_message(Log::Log_Priority::ERROR, "Neural_Nework_Layer::expand_bias",
-            "Bias Matrix does not exist. Exiting");
+    if (m_previous_layer_neurons == 0 || data == NULL ||
+        (layer_type != Layer_Type::WEIGHTS && layer_type != Layer_Type::BIASES)) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Layer::attach_matrix",
+            "Only the weights and biases of a hidden or output layer can be attached");
         exit(EXIT_FAILURE);
     }
 
-    const Matrix& old_bias = get_const(Layer_Type::BIASES);
-    Matrix new_bias = Matrix(old_bias.rows(), batch_size);
-
-    for (size_t i = 0; i < batch_size; ++i) {
-        for (size_t j = 0; j < old_bias.rows(); ++j) {
-            new_bias.set(j, i, old_bias.get(j, 0));
-        }
+    if (layer_type == Layer_Type::WEIGHTS) {
+        delete m_weights;
+        m_weights = new Matrix(m_num_neurons, m_previous_layer_neurons, data);
+    }
+    else {
+        delete m_biases;
+        m_biases = new Matrix(m_num_neurons, 1, data);
     }
-
-    write_matrix(new_bias, Layer_Type::BIASES);
 }
 
-void Neural_Network_Layer::shrink_bias(void) {
+void Neural_Network_Layer::to_inference_only(void) {
 
-    if (!exists(Layer_Type::BIASES)) {
-        Log::log_message(Log::Log_Priority::ERROR, "Neural_Nework_Layer::expand_bias",
-            "Bias Matrix does not exist. Exiting");
-        exit(EXIT_FAILURE);
-    }
+    if (m_outputs != NULL) { delete m_outputs; m_outputs = NULL; }
+    if (m_errors != NULL) { delete m_errors; m_errors = NULL; }
+    if (m_new_weights != NULL) { delete m_new_weights; m_new_weights = NULL; }
+    if (m_z != NULL) { delete m_z; m_z = NULL; }
+
+    m_inference_only = true;
+}
 
-    const Matrix& old_bias = get_const(Layer_Type::BIASES);
-    Matrix new_bias = Matrix(old_bias.rows(), 1);
-    old_bias.get_column(0, new_bias);
+bool Neural_Network_Layer::is_inference_only(void) const {
 
-    write_matrix(new_bias, Layer_Type::BIASES);
+    return m_inference_only;
 }
 
 float Neural_Network_Layer_NS::random_float(void) {
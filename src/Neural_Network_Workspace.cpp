@@ -0,0 +1,255 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Neural_Network_Workspace.hpp"
+
+using Neural_Network_Workspace_NS::Neural_Network_Workspace;
+using Neural_Network_Workspace_NS::Workspace_Type;
+
+/**
+ * Round a number of floats up so the next slice starts on an alignment boundary
+ * @param elements Number of floats
+ * @returns Returns the padded number of floats
+ */
+static size_t aligned_elements(size_t elements) {
+
+    const size_t per_line = NEURAL_NETWORK_WORKSPACE_ALIGNMENT / sizeof(float);
+    return ((elements + per_line - 1) / per_line) * per_line;
+}
+
+Neural_Network_Workspace::Neural_Network_Workspace(const std::vector<size_t>& layer_info, size_t batch_size) {
+
+    if (layer_info.size() < 2 || batch_size == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Workspace::Neural_Network_Workspace",
+            "A workspace needs at least two layers and a non-zero batch size");
+        exit(EXIT_FAILURE);
+    }
+
+    m_layer_info = layer_info;
+    m_batch_size = batch_size;
+
+    m_views = (Matrix**)calloc(m_layer_info.size() * NEURAL_NETWORK_WORKSPACE_TYPES, sizeof(Matrix*));
+    if (m_views == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Workspace::Neural_Network_Workspace",
+            "Unable to allocate memory for the workspace views");
+        exit(EXIT_FAILURE);
+    }
+
+    // Create the views up front. They get pointed at the arena in bind_views
+    for (size_t i = 1; i < m_layer_info.size(); ++i) {
+        for (size_t j = 0; j < NEURAL_NETWORK_WORKSPACE_TYPES; ++j) {
+            m_views[(i * NEURAL_NETWORK_WORKSPACE_TYPES) + j] = new Matrix(0, 0, NULL);
+        }
+    }
+    m_ones = new Matrix(0, 0, NULL);
+    m_inputs = new Matrix(0, 0, NULL);
+    m_labels = new Matrix(0, 0, NULL);
+
+    m_active_inputs = (size_t*)calloc(m_layer_info.front(), sizeof(size_t));
+    if (m_active_inputs == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Workspace::Neural_Network_Workspace",
+            "Unable to allocate memory for the active input indices");
+        exit(EXIT_FAILURE);
+    }
+
+    allocate(batch_size);
+}
+
+Neural_Network_Workspace::~Neural_Network_Workspace() {
+
+    if (m_views != NULL) {
+        for (size_t i = 0; i < m_layer_info.size() * NEURAL_NETWORK_WORKSPACE_TYPES; ++i) {
+            if (m_views[i] != NULL) { delete m_views[i]; }
+        }
+        free(m_views);
+        m_views = NULL;
+    }
+
+    if (m_ones != NULL) {
+        delete m_ones;
+        m_ones = NULL;
+    }
+
+    if (m_inputs != NULL) {
+        delete m_inputs;
+        m_inputs = NULL;
+    }
+
+    if (m_labels != NULL) {
+        delete m_labels;
+        m_labels = NULL;
+    }
+
+    if (m_active_inputs != NULL) {
+        free(m_active_inputs);
+        m_active_inputs = NULL;
+    }
+
+    if (m_arena != NULL) {
+        free(m_arena);
+        m_arena = NULL;
+    }
+}
+
+void Neural_Network_Workspace::allocate(size_t max_batch_size) {
+
+    // Work out how many floats the arena needs, padding each slice to the alignment
+    size_t elements = aligned_elements(max_batch_size);
+    elements += aligned_elements(m_layer_info.front() * max_batch_size);
+    elements += aligned_elements(m_layer_info.back() * max_batch_size);
+
+    for (size_t i = 1; i < m_layer_info.size(); ++i) {
+        // OUTPUTS and ERRORS are both [neurons x batch_size]
+        elements += 2 * aligned_elements(m_layer_info[i] * max_batch_size);
+        elements += aligned_elements(m_layer_info[i] * m_layer_info[i - 1]);
+        elements += aligned_elements(m_layer_info[i]);
+    }
+
+    if (m_arena != NULL) { free(m_arena); }
+
+    m_arena = (float*)aligned_alloc(NEURAL_NETWORK_WORKSPACE_ALIGNMENT, elements * sizeof(float));
+    Allocation_Counter_NS::record();
+
+    if (m_arena == NULL) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Workspace::allocate",
+            std::format("Unable to allocate {} bytes for the workspace arena", elements * sizeof(float)));
+        exit(EXIT_FAILURE);
+    }
+
+    memset(m_arena, '\0', elements * sizeof(float));
+    m_arena_elements = elements;
+    m_max_batch_size = max_batch_size;
+
+    // The ones column sits at the start of the arena and only needs filling once
+    for (size_t i = 0; i < max_batch_size; ++i) {
+        m_arena[i] = 1.0f;
+    }
+
+    bind_views();
+}
+
+void Neural_Network_Workspace::bind_views(void) {
+
+    // Slices are laid out for m_max_batch_size so shrinking the batch never moves anything
+    float* current = m_arena;
+
+    m_ones->rebind(m_batch_size, 1, current);
+    current += aligned_elements(m_max_batch_size);
+
+    m_inputs->rebind(m_layer_info.front(), m_batch_size, current);
+    current += aligned_elements(m_layer_info.front() * m_max_batch_size);
+    m_labels->rebind(m_layer_info.back(), m_batch_size, current);
+    current += aligned_elements(m_layer_info.back() * m_max_batch_size);
+
+    for (size_t i = 1; i < m_layer_info.size(); ++i) {
+        Matrix** views = m_views + (i * NEURAL_NETWORK_WORKSPACE_TYPES);
+        const size_t batch_slice = aligned_elements(m_layer_info[i] * m_max_batch_size);
+
+        views[Workspace_Type::OUTPUTS]->rebind(m_layer_info[i], m_batch_size, current);
+        current += batch_slice;
+        views[Workspace_Type::ERRORS]->rebind(m_layer_info[i], m_batch_size, current);
+        current += batch_slice;
+
+        views[Workspace_Type::NABLA_W]->rebind(m_layer_info[i], m_layer_info[i - 1], current);
+        current += aligned_elements(m_layer_info[i] * m_layer_info[i - 1]);
+        views[Workspace_Type::NABLA_B]->rebind(m_layer_info[i], 1, current);
+        current += aligned_elements(m_layer_info[i]);
+    }
+}
+
+size_t Neural_Network_Workspace::batch_size(void) const {
+
+    return m_batch_size;
+}
+
+size_t Neural_Network_Workspace::num_layers(void) const {
+
+    return m_layer_info.size();
+}
+
+bool Neural_Network_Workspace::matches(const std::vector<size_t>& layer_info) const {
+
+    return m_layer_info == layer_info;
+}
+
+bool Neural_Network_Workspace::resize(size_t batch_size) {
+
+    if (batch_size == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Workspace::resize",
+            "Cannot resize a workspace to a batch size of 0");
+        exit(EXIT_FAILURE);
+    }
+
+    if (batch_size == m_batch_size) { return false; }
+
+    m_batch_size = batch_size;
+
+    if (batch_size > m_max_batch_size) {
+        allocate(batch_size);
+        return true;
+    }
+
+    bind_views();
+    return false;
+}
+
+Matrix& Neural_Network_Workspace::get(Workspace_Type workspace_type, size_t layer) {
+
+    if (layer == 0 || layer >= m_layer_info.size() || (size_t)workspace_type >= NEURAL_NETWORK_WORKSPACE_TYPES) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Workspace::get",
+            std::format("Invalid workspace entry requested: type {} for layer {}", (int)workspace_type, layer));
+        exit(EXIT_FAILURE);
+    }
+
+    return *(m_views[(layer * NEURAL_NETWORK_WORKSPACE_TYPES) + workspace_type]);
+}
+
+const Matrix& Neural_Network_Workspace::get_const(Workspace_Type workspace_type, size_t layer) const {
+
+    if (layer == 0 || layer >= m_layer_info.size() || (size_t)workspace_type >= NEURAL_NETWORK_WORKSPACE_TYPES) {
+        Log::log_message(Log::Log_Priority::ERROR, "Neural_Network_Workspace::get_const",
+            std::format("Invalid workspace entry requested: type {} for layer {}", (int)workspace_type, layer));
+        exit(EXIT_FAILURE);
+    }
+
+    return *(m_views[(layer * NEURAL_NETWORK_WORKSPACE_TYPES) + workspace_type]);
+}
+
+const Matrix& Neural_Network_Workspace::ones(void) const {
+
+    return *m_ones;
+}
+
+Matrix& Neural_Network_Workspace::inputs(void) {
+
+    return *m_inputs;
+}
+
+Matrix& Neural_Network_Workspace::labels(void) {
+
+    return *m_labels;
+}
+
+size_t* Neural_Network_Workspace::active_inputs(void) {
+
+    return m_active_inputs;
+}
+
+size_t Neural_Network_Workspace::count_step(void) {
+
+    return ++m_steps;
+}
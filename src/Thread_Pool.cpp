@@ -0,0 +1,199 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#include "include/Thread_Pool.hpp"
+
+using Thread_Pool_NS::Thread_Pool;
+
+Thread_Pool::Thread_Pool(size_t num_threads) {
+
+    if (num_threads == 0) {
+        Log::log_message(Log::Log_Priority::ERROR, "Thread_Pool::Thread_Pool",
+            "Cannot create a Thread_Pool with 0 threads");
+        exit(EXIT_FAILURE);
+    }
+
+    m_num_threads = num_threads;
+    m_ranges = new Task_Range[num_threads];
+
+    // The caller is one of the threads, so only start num_threads - 1 workers
+    for (size_t i = 1; i < num_threads; ++i) {
+        m_workers.emplace_back(&Thread_Pool::worker_loop, this, i);
+    }
+}
+
+Thread_Pool::~Thread_Pool() {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wake.notify_all();
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers[i].join();
+    }
+
+    delete[] m_ranges;
+}
+
+size_t Thread_Pool::size(void) const {
+
+    return m_num_threads;
+}
+
+void Thread_Pool::worker_loop(size_t worker) {
+
+    size_t seen_generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&]() { return m_shutdown || m_generation != seen_generation; });
+
+            if (m_shutdown) { return; }
+            seen_generation = m_generation;
+        }
+
+        drain(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_active_workers;
+            if (m_active_workers == 0) { m_finished.notify_one(); }
+        }
+    }
+}
+
+void Thread_Pool::drain(size_t worker) {
+
+    size_t index = 0;
+
+    if (m_stealing) {
+        while (pop_task(worker, index) || steal_task(worker, index)) {
+            m_task(m_context, worker, index);
+        }
+        return;
+    }
+
+    index = m_next_task.fetch_add(1, std::memory_order_relaxed);
+
+    while (index < m_num_tasks) {
+        m_task(m_context, worker, index);
+        index = m_next_task.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Thread_Pool::pop_task(size_t worker, size_t& index) {
+
+    std::atomic<uint64_t>& range = m_ranges[worker].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+
+    // Thieves may shrink the end at the same time, so the front is claimed with a compare and swap
+    while (true) {
+        const uint64_t begin = current >> 32;
+        const uint64_t end = current & 0xFFFFFFFF;
+
+        if (begin >= end) { return false; }
+
+        if (range.compare_exchange_weak(current, ((begin + 1) << 32) | end, std::memory_order_acq_rel)) {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+bool Thread_Pool::steal_task(size_t worker, size_t& index) {
+
+    // Visit the other threads starting from the next one, so thieves spread across victims
+    for (size_t i = 1; i < m_num_threads; ++i) {
+        std::atomic<uint64_t>& range = m_ranges[(worker + i) % m_num_threads].range;
+        uint64_t current = range.load(std::memory_order_acquire);
+
+        while (true) {
+            const uint64_t begin = current >> 32;
+            const uint64_t end = current & 0xFFFFFFFF;
+
+            if (begin >= end) { break; }
+
+            // Take the back half, rounding up so a single remaining task can be stolen too
+            const uint64_t split = end - ((end - begin + 1) / 2);
+
+            if (range.compare_exchange_weak(current, (begin << 32) | split, std::memory_order_acq_rel)) {
+                // Our own range is empty, so nobody else is updating it
+                m_ranges[worker].range.store(((split + 1) << 32) | end, std::memory_order_release);
+                index = split;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void Thread_Pool::execute(void (*task)(void* context, size_t worker, size_t index), void* context, size_t num_tasks,
+    bool stealing) {
+
+    if (num_tasks == 0) { return; }
+
+    if (stealing && num_tasks > 0xFFFFFFFF) {
+        Log::log_message(Log::Log_Priority::ERROR, "Thread_Pool::run_stealing",
+            "run_stealing supports at most 2^32 - 1 tasks");
+        exit(EXIT_FAILURE);
+    }
+
+    // Nothing to hand out if there are no workers, or only a single task
+    if (m_workers.empty() || num_tasks == 1) {
+        for (size_t i = 0; i < num_tasks; ++i) {
+            task(context, 0, i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = task;
+        m_context = context;
+        m_num_tasks = num_tasks;
+        m_next_task.store(0, std::memory_order_relaxed);
+        m_stealing = stealing;
+
+        // Start every thread on an even, contiguous share of the tasks
+        for (size_t i = 0; stealing && i < m_num_threads; ++i) {
+            const uint64_t begin = (num_tasks * i) / m_num_threads;
+            const uint64_t end = (num_tasks * (i + 1)) / m_num_threads;
+            m_ranges[i].range.store((begin << 32) | end, std::memory_order_relaxed);
+        }
+
+        m_active_workers = m_workers.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    // Work alongside the pool
+    drain(0);
+
+    // Every worker checks in once per generation, so once they have all checked in no task is still running
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [&]() { return m_active_workers == 0; });
+}
+
+size_t Thread_Pool_NS::hardware_threads(void) {
+
+    size_t threads = std::thread::hardware_concurrency();
+    return (threads == 0) ? 1 : threads;
+}
@@ -0,0 +1,64 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Counts heap allocations so debug builds can check that the training step is
+ * allocation-free. Tracking is compiled in when ALLOCATION_COUNTER_ENABLED is set to 1
+ * (the Debug CMake configuration does this); otherwise record() is a no-op and
+ * allocations() always returns 0.
+ *
+ * When enabled, both Matrix storage (calloc) and the global operator new are counted.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#ifndef ALLOCATION_COUNTER_ENABLED
+#define ALLOCATION_COUNTER_ENABLED 0
+#endif
+
+/* Standard dependencies */
+#include <atomic>
+#include <stddef.h>
+
+/* Local dependencies */
+
+namespace Allocation_Counter_NS {
+
+/* Running total of counted allocations, defined in Allocation_Counter.cpp */
+extern std::atomic<size_t> allocation_count;
+
+/**
+ * Record a heap allocation
+ */
+inline void record(void) {
+
+    if (ALLOCATION_COUNTER_ENABLED) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Get the number of heap allocations recorded so far
+ * @returns Returns the number of allocations, always 0 when tracking is disabled
+ */
+inline size_t allocations(void) {
+
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+};
+
+#endif
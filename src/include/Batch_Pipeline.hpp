@@ -0,0 +1,140 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Background loader for the training loops. Loader threads assemble mini-batches into
+ * a ring of preallocated slots while the trainer consumes the previous ones, so batch
+ * assembly overlaps with the forward / backward pass instead of running in front of it.
+ *
+ * The ring is a bounded queue in the style of Vyukov's: every slot carries a sequence
+ * number saying whose turn it is. Batch k always lands in slot k % num_slots and loader
+ * k % num_loaders always builds it, so producers never contend with each other and the
+ * trainer sees the batches in schedule order no matter how many loaders there are. The
+ * only synchronisation is the per-slot sequence; threads only block (via atomic wait)
+ * when the ring is full or empty.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef BATCH_PIPELINE_HPP
+#define BATCH_PIPELINE_HPP
+
+/* Standard dependencies */
+#include <atomic>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/* Local dependencies */
+#include "Log.hpp"
+#include "Matrix.hpp"
+#include "MNIST_Utils.hpp"
+
+namespace Batch_Pipeline_NS {
+
+/* One preallocated batch in the ring, on its own cache line(s) so loaders don't false share */
+struct alignas(64) Batch_Pipeline_Slot {
+    /* Whose turn it is: k means loader for batch k may fill it, k + 1 means batch k is ready */
+    std::atomic<size_t> sequence{0};
+    /* Exactly one of images / raw_images is set, matching the Pixel_Format of the MNIST_Images */
+    Matrix* images = NULL;
+    Byte_Matrix* raw_images = NULL;
+    Matrix* labels = NULL;
+    /* Position of the batch in the schedule */
+    size_t batch = 0;
+};
+
+class Batch_Pipeline {
+private:
+    /* Private data elements */
+    const MNIST_Utils_NS::MNIST_Images& m_images;
+    const MNIST_Utils_NS::MNIST_Labels& m_labels;
+
+    size_t m_batch_size = 0;
+    size_t* m_schedule = NULL;
+    size_t m_num_batches = 0;
+
+    Batch_Pipeline_Slot* m_slots = NULL;
+    size_t m_num_slots = 0;
+
+    std::vector<std::thread> m_loaders;
+
+    /* Only touched by the consuming thread */
+    size_t m_next_batch = 0;
+    size_t m_stalls = 0;
+
+    /* Private functions */
+
+    /**
+     * Main loop for each loader thread
+     * @param loader Index of the loader, which picks the batches it builds
+     * @param num_loaders Total number of loaders
+     */
+    void loader_loop(size_t loader, size_t num_loaders);
+
+public:
+    /* Public functions */
+
+    /**
+     * Create a new Batch_Pipeline and start its loader threads
+     * @param images The images to build batches from
+     * @param labels The matching labels
+     * @param batch_size Number of images per batch
+     * @param schedule Image indices to produce, in order. Batch k is gathered from
+     * schedule[k * batch_size] to schedule[((k + 1) * batch_size) - 1]. The array is copied
+     * @param num_batches Number of batches in schedule
+     * @param num_loaders Number of loader threads
+     * @param num_slots Number of preallocated batches in the ring. Must be at least 2
+     */
+    Batch_Pipeline(const MNIST_Utils_NS::MNIST_Images& images, const MNIST_Utils_NS::MNIST_Labels& labels,
+        size_t batch_size, const size_t* schedule, size_t num_batches, size_t num_loaders, size_t num_slots);
+
+    /**
+     * Destructor for Batch_Pipeline, stopping and joining the loaders
+     */
+    ~Batch_Pipeline();
+
+    /* Loaders hold a pointer to the pipeline, so it can't be copied or moved */
+    Batch_Pipeline(const Batch_Pipeline& target) = delete;
+    Batch_Pipeline& operator=(const Batch_Pipeline& target) = delete;
+
+    /**
+     * Get the next batch in schedule order, waiting for it if it isn't built yet. Must be
+     * paired with release() before the next call
+     * @returns Returns a reference to the slot holding the batch
+     */
+    const Batch_Pipeline_Slot& acquire(void);
+
+    /**
+     * Hand the batch from the last acquire() back to the loaders
+     */
+    void release(void);
+
+    /**
+     * Get the number of batches that haven't been acquired yet
+     * @returns Returns the number of batches left
+     */
+    size_t remaining(void) const;
+
+    /**
+     * Get the number of times acquire() found its batch not ready and had to wait
+     * @returns Returns the number of stalls
+     */
+    size_t stalls(void) const;
+};
+
+};
+
+#endif
@@ -0,0 +1,220 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Vectorizable exp / log / sigmoid used by the activation and cost functions.
+ *
+ * Two precisions are available and can be switched at runtime with set_precision:
+ *
+ * EXACT - every element goes through libm (expf / logf / log10f). Correctly rounded
+ *         or within 1 ulp depending on the libm, but one scalar call per element.
+ *
+ * FAST  - branch-free polynomial approximations that the compiler vectorizes. The
+ *         array functions are compiled once per instruction set and the widest one
+ *         selected by Matrix_Kernels is used. Measured error bounds over the stated
+ *         domains:
+ *
+ *           exp      x in [-87.3, 88.37]        <= 1e-7 relative. Inputs are clamped to
+ *                                                that range, so very negative inputs return
+ *                                                ~1.2e-38 rather than 0 and large inputs
+ *                                                return ~2.4e38 rather than inf
+ *           log      x in [0.5, 2]              <= 5e-8 absolute
+ *                    other normal x > 0         <= 1e-7 relative. 0 returns -inf, negative
+ *                                                inputs and NaN return NaN, denormals are
+ *                                                treated as FLT_MIN
+ *           log10    x in [0.5, 2]              <= 5e-8 absolute
+ *           sigmoid  all finite x               <= 1e-7 absolute
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef FAST_MATH_HPP
+#define FAST_MATH_HPP
+
+/* Standard dependencies */
+#include <bit>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Local dependencies */
+
+namespace Fast_Math_NS {
+
+typedef enum {
+    EXACT = 0,
+    FAST = 1
+} Math_Precision;
+
+/**
+ * Set the precision used by the array functions below
+ * @param precision EXACT to use libm, FAST to use the vectorized approximations
+ */
+void set_precision(Math_Precision precision);
+
+/**
+ * Get the precision used by the array functions below
+ * @returns Returns the active Math_Precision
+ */
+Math_Precision get_precision(void);
+
+/**
+ * Calculate exp for an array of floats. source and destination may be the same array
+ * @param source Input values
+ * @param destination Output values
+ * @param elements Number of elements
+ */
+void exp(const float* source, float* destination, size_t elements);
+
+/**
+ * Calculate the natural log for an array of floats. source and destination may be the same array
+ * @param source Input values
+ * @param destination Output values
+ * @param elements Number of elements
+ */
+void log(const float* source, float* destination, size_t elements);
+
+/**
+ * Calculate log10 for an array of floats. source and destination may be the same array
+ * @param source Input values
+ * @param destination Output values
+ * @param elements Number of elements
+ */
+void log10(const float* source, float* destination, size_t elements);
+
+/**
+ * Calculate the sigmoid, 1 / (1 + exp(-z)), for an array of floats. source and destination
+ * may be the same array
+ * @param source Input values
+ * @param destination Output values
+ * @param elements Number of elements
+ */
+void sigmoid(const float* source, float* destination, size_t elements);
+
+/**
+ * Add a bias to every column of a row-major [rows x cols] Matrix and apply the sigmoid, in one
+ * pass. z receives z + bias and destination receives its sigmoid. destination may be z, in
+ * which case only the activation is kept
+ * @param z Pre-activation values, updated in place with the bias added
+ * @param bias One value per row
+ * @param rows Number of rows
+ * @param cols Number of columns
+ * @param destination Output values
+ */
+void bias_sigmoid(float* z, const float* bias, size_t rows, size_t cols, float* destination);
+
+/**
+ * Multiply an array by the sigmoid derivative, taken from the sigmoid's own output as
+ * s * (1 - s) so no exp is needed. Exact at either precision. source and destination may be the
+ * same array
+ * @param source Values to multiply, e.g. the error propagated back from the next layer
+ * @param outputs Sigmoid outputs s
+ * @param destination Output values, source * s * (1 - s)
+ * @param elements Number of elements
+ */
+void multiply_sigmoid_prime(const float* source, const float* outputs, float* destination, size_t elements);
+
+/**
+ * Scalar fast exp. Range reduction to x = n * ln(2) + r with |r| <= ln(2) / 2, then a
+ * degree 7 polynomial for exp(r) and 2^n built directly in the exponent bits
+ * @param x Input value
+ * @returns Returns an approximation of e^x
+ */
+inline float fast_exp(float x) {
+
+    // Clamp so that 2^n stays a normal float (n in [-126, 127])
+    x = (x < -87.3f) ? -87.3f : x;
+    x = (x > 88.3762626647949f) ? 88.3762626647949f : x;
+
+    // Round x / ln(2) to the nearest integer. Adding 1.5 * 2^23 forces the rounding
+    // without needing a rounding instruction, which keeps this vectorizable on SSE2
+    const float shifter = 12582912.0f;
+    float n = (x * 1.44269504088896341f) + shifter;
+    n = n - shifter;
+
+    // r = x - n * ln(2), with ln(2) split in two to keep the reduction exact
+    float r = x - (n * 0.693359375f);
+    r = r - (n * -2.12194440e-4f);
+
+    // Polynomial from Cephes expf
+    float p = 1.9875691500e-4f;
+    p = (p * r) + 1.3981999507e-3f;
+    p = (p * r) + 8.3334519073e-3f;
+    p = (p * r) + 4.1665795894e-2f;
+    p = (p * r) + 1.6666665459e-1f;
+    p = (p * r) + 5.0000001201e-1f;
+    p = (p * r * r) + r + 1.0f;
+
+    // Scale by 2^n by building the exponent bits directly
+    int32_t bits = ((int32_t)n + 127) << 23;
+    return p * std::bit_cast<float>(bits);
+}
+
+/**
+ * Scalar fast natural log. Splits x into mantissa m in [sqrt(0.5), sqrt(2)) and
+ * exponent e, then evaluates a polynomial for log(m)
+ * @param x Input value
+ * @returns Returns an approximation of ln(x)
+ */
+inline float fast_log(float x) {
+
+    const float smallest_normal = 1.17549435e-38f;
+    float clamped = (x < smallest_normal) ? smallest_normal : x;
+
+    int32_t bits = std::bit_cast<int32_t>(clamped);
+    // frexp style split: m in [0.5, 1), clamped = m * 2^e
+    float e = (float)(((bits >> 23) & 0xFF) - 126);
+    float m = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F000000);
+
+    // Move m into [sqrt(0.5), sqrt(2)) so the polynomial argument is centered on zero
+    bool small = m < 0.707106781186547524f;
+    e = small ? e - 1.0f : e;
+    float f = small ? (m + m) - 1.0f : m - 1.0f;
+
+    // Polynomial from Cephes logf
+    float z = f * f;
+    float y = 7.0376836292e-2f;
+    y = (y * f) - 1.1514610310e-1f;
+    y = (y * f) + 1.1676998740e-1f;
+    y = (y * f) - 1.2420140846e-1f;
+    y = (y * f) + 1.4249322787e-1f;
+    y = (y * f) - 1.6668057665e-1f;
+    y = (y * f) + 2.0000714765e-1f;
+    y = (y * f) - 2.4999993993e-1f;
+    y = (y * f) + 3.3333331174e-1f;
+    y = y * f * z;
+
+    y = y + (e * -2.12194440e-4f);
+    y = y - (0.5f * z);
+    float result = f + y + (e * 0.693359375f);
+
+    // Special values: log(0) = -inf, log(negative or NaN) = NaN
+    const float negative_infinity = std::bit_cast<float>((int32_t)0xFF800000);
+    const float not_a_number = std::bit_cast<float>((int32_t)0x7FC00000);
+    result = (x == 0.0f) ? negative_infinity : result;
+    result = ((x < 0.0f) | (x != x)) ? not_a_number : result;
+    return result;
+}
+
+/**
+ * Scalar fast sigmoid built on fast_exp
+ * @param z Input value
+ * @returns Returns an approximation of 1 / (1 + e^-z)
+ */
+inline float fast_sigmoid(float z) {
+
+    return 1.0f / (1.0f + fast_exp(-z));
+}
+
+};
+
+#endif
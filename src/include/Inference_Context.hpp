@@ -0,0 +1,129 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Scratch space for a forward pass. Inference only needs the activations of the layer being
+ * computed and the one before it, so two [max_neurons x max_batch_size] buffers are used in
+ * turn out of a single 64 byte aligned arena. Each thread (or request) owns its own context,
+ * so any number of them can run inference against one const Neural_Network at the same time.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef INFERENCE_CONTEXT_HPP
+#define INFERENCE_CONTEXT_HPP
+
+#define INFERENCE_CONTEXT_ALIGNMENT 64
+
+/* Standard dependencies */
+#include <cstdlib>
+#include <vector>
+
+/* Local dependencies */
+#include "Log.hpp"
+#include "Matrix.hpp"
+
+/* Using */
+using Matrix = Matrix_NS::Matrix<float>;
+
+/* Definitions */
+namespace Inference_Context_NS {
+
+class Inference_Context {
+private:
+    /* Private data elements */
+    std::vector<size_t> m_layer_info;
+    size_t m_batch_size = 0;
+    size_t m_max_batch_size = 0;
+    float* m_arena = NULL;
+    /* One view per layer, pointing at whichever of the two buffers that layer writes. View 0 is a
+     * single-column float copy of the input, used by the single-sample path */
+    Matrix** m_views = NULL;
+
+    /* Private functions */
+
+    /**
+     * Allocate the arena for max_batch_size and point every view into it
+     * @param max_batch_size The largest batch the arena should hold
+     */
+    void allocate(size_t max_batch_size);
+
+    /**
+     * Point every view at its buffer for the current batch size
+     */
+    void bind_views(void);
+
+public:
+    /* Public functions */
+
+    /**
+     * Create a new Inference_Context
+     * @param layer_info Vector of size_t containing the sizes of each layer, including the input layer
+     * @param max_batch_size The largest number of columns expected per inference call
+     */
+    Inference_Context(const std::vector<size_t>& layer_info, size_t max_batch_size);
+
+    /**
+     * Destructor for Inference_Context
+     */
+    ~Inference_Context();
+
+    /* The views point into m_arena, so copying would leave two owners */
+    Inference_Context(const Inference_Context& target) = delete;
+    Inference_Context& operator=(const Inference_Context& target) = delete;
+
+    /**
+     * Get the batch size the views are currently shaped for
+     * @returns Returns the current batch size
+     */
+    size_t batch_size(void) const;
+
+    /**
+     * Get the number of layers, including the input layer
+     * @returns Returns the number of layers
+     */
+    size_t num_layers(void) const;
+
+    /**
+     * Get the number of neurons in a layer the context was built for
+     * @param layer The layer index, with 0 being the input layer
+     * @returns Returns the number of neurons
+     */
+    size_t layer_size(size_t layer) const;
+
+    /**
+     * Reshape the context for a new batch size. Batches up to the largest size seen so far
+     * reuse the arena; larger batches reallocate it
+     * @param batch_size The number of columns in the next inference call
+     * @returns Returns true if the arena had to be reallocated
+     */
+    bool resize(size_t batch_size);
+
+    /**
+     * Get the activations of a layer. Layer i shares its buffer with layer i - 2, so only the
+     * previous layer's activations are valid while a layer is being computed
+     * @param layer The layer index, starting at 1 for the first hidden layer
+     * @returns Returns a reference to a [neurons x batch_size] Matrix view
+     */
+    Matrix& activations(size_t layer);
+
+    /**
+     * Get the single-sample input staging buffer, for inputs that need converting before use
+     * @returns Returns a reference to a [input neurons x 1] Matrix view
+     */
+    Matrix& inputs(void);
+};
+
+};
+
+#endif
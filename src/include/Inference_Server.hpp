@@ -0,0 +1,263 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Long-lived inference daemon. A Neural_Network is loaded once and served over a Unix domain
+ * socket. Requests arriving from any number of connections are collected into one
+ * column-stacked batch, which runs through a single inference call once it is full or its
+ * oldest request has waited max_wait_us, whichever comes first.
+ *
+ * Wire format, in host byte order since the socket never leaves the machine:
+ *
+ * Request:  uint8_t[input_neurons] pixels (784 for MNIST)
+ * Response: float[output_neurons] softmax probabilities (10 for MNIST)
+ *
+ * A connection can pipeline as many requests as it likes. Responses come back in the order
+ * the requests were sent. A client that stops reading its responses is pushed back: once it has
+ * INFERENCE_SERVER_MAX_PENDING_OUTPUT bytes outstanding, its requests are left unread until
+ * the responses drain.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef INFERENCE_SERVER_HPP
+#define INFERENCE_SERVER_HPP
+
+#define INFERENCE_SERVER_DEBUG 1
+/* Defaults for the batching limits */
+#define INFERENCE_SERVER_MAX_BATCH_SIZE 64
+#define INFERENCE_SERVER_MAX_WAIT_US 500
+#define INFERENCE_SERVER_LISTEN_BACKLOG 512
+#define INFERENCE_SERVER_MAX_EVENTS 256
+/* Number of requests a connection can read in one recv call */
+#define INFERENCE_SERVER_READ_REQUESTS 16
+/* Bytes of responses, sent or still being computed, a connection can have outstanding before
+ * the server stops reading its requests */
+#define INFERENCE_SERVER_MAX_PENDING_OUTPUT (256 * 1024)
+
+/* Standard dependencies */
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Local dependencies */
+#include "Inference_Context.hpp"
+#include "Log.hpp"
+#include "Matrix.hpp"
+#include "Neural_Network.hpp"
+
+/* Using */
+using Matrix = Matrix_NS::Matrix<float>;
+using Byte_Matrix = Matrix_NS::Matrix<uint8_t>;
+using Neural_Network = Neural_Network_NS::Neural_Network;
+using Inference_Context = Inference_Context_NS::Inference_Context;
+
+/* Definitions */
+namespace Inference_Server_NS {
+
+/* State for one client connection */
+struct Inference_Connection {
+    int fd = -1;
+    /* Bytes received that don't make up a full request yet, plus room for more */
+    uint8_t* input = NULL;
+    size_t received = 0;
+    /* Responses that couldn't be sent without blocking */
+    std::vector<uint8_t> output;
+    /* Requests from this connection waiting in the current batch */
+    size_t pending = 0;
+    /* Events currently registered with epoll */
+    uint32_t events = 0;
+    /* The client shut down its end for writing; answer what it sent, then close */
+    bool read_closed = false;
+    bool closed = false;
+    bool needs_flush = false;
+};
+
+class Inference_Server {
+private:
+    /* Private data elements */
+    const Neural_Network& m_network;
+    std::string m_socket_path;
+    size_t m_max_batch_size = 0;
+    size_t m_max_wait_us = 0;
+    size_t m_input_size = 0;
+    size_t m_output_size = 0;
+
+    int m_listen_fd = -1;
+    int m_epoll_fd = -1;
+    int m_timer_fd = -1;
+    int m_wake_fd = -1;
+    std::atomic<bool> m_running{false};
+
+    /* Requests as received, one per row, and the same requests stacked as columns */
+    uint8_t* m_staging = NULL;
+    uint8_t* m_batch_data = NULL;
+    float* m_results_data = NULL;
+    Byte_Matrix* m_batch = NULL;
+    Matrix* m_results = NULL;
+    Inference_Context* m_context = NULL;
+
+    /* Connection each request in the current batch came from */
+    Inference_Connection** m_batch_owners = NULL;
+    size_t m_batch_count = 0;
+
+    std::unordered_map<int, Inference_Connection*> m_connections;
+    /* Connections with responses to send after the current batch */
+    std::vector<Inference_Connection*> m_flush;
+    /* Closed connections, freed once no request in the batch points at them */
+    std::vector<Inference_Connection*> m_closed;
+
+    size_t m_requests_served = 0;
+    size_t m_batches_run = 0;
+
+    /* Private functions */
+
+    /**
+     * Create, bind and listen on the Unix domain socket, replacing a stale socket file
+     */
+    void open_socket(void);
+
+    /**
+     * Add a file descriptor to the epoll set
+     * @param fd The file descriptor
+     * @param events Events to wait for
+     * @param data Pointer handed back with each event
+     */
+    void watch(int fd, uint32_t events, void* data);
+
+    /**
+     * Accept every pending connection on the listening socket
+     */
+    void accept_connections(void);
+
+    /**
+     * Read whatever a connection has sent, queueing each complete request into the batch
+     * @param connection The connection to read from
+     */
+    void read_connection(Inference_Connection& connection);
+
+    /**
+     * Queue a complete request into the current batch, running the batch if it fills up
+     * @param connection The connection the request came from
+     * @param request Pointer to m_input_size bytes
+     */
+    void queue_request(Inference_Connection& connection, const uint8_t* request);
+
+    /**
+     * Run inference over the current batch and hand each result back to its connection
+     */
+    void run_batch(void);
+
+    /**
+     * Send as much of a connection's queued output as the socket takes without blocking
+     * @param connection The connection to send to
+     */
+    void flush_connection(Inference_Connection& connection);
+
+    /**
+     * Check whether a connection has too many responses outstanding to read more requests
+     * @param connection The connection to check
+     * @returns Returns true if the connection's queued and in-flight responses are at the cap
+     */
+    bool backlogged(const Inference_Connection& connection) const;
+
+    /**
+     * Update the events a connection is watched for: EPOLLIN unless it is backlogged, and
+     * EPOLLOUT while it has output left to send
+     * @param connection The connection to update
+     */
+    void update_events(Inference_Connection& connection);
+
+    /**
+     * Stop watching and close a connection. It is freed once the batch no longer needs it
+     * @param connection The connection to close
+     */
+    void close_connection(Inference_Connection& connection);
+
+    /**
+     * Free closed connections that have no requests left in the batch
+     */
+    void release_connections(void);
+
+    /**
+     * Arm the batch deadline timer
+     * @param microseconds Time until the deadline. 0 fires as soon as possible
+     */
+    void arm_timer(size_t microseconds);
+
+    /**
+     * Disarm the batch deadline timer, dropping any expiration not yet read
+     */
+    void disarm_timer(void);
+
+public:
+    /* Public functions */
+
+    /**
+     * Create a new Inference_Server listening on a Unix domain socket
+     * @param network The model to serve. It must outlive the server and isn't modified
+     * @param socket_path Path of the socket to create
+     * @param max_batch_size Most requests run through one inference call
+     * @param max_wait_us Longest time a request waits for the batch to fill, in microseconds
+     */
+    Inference_Server(const Neural_Network& network, const char* socket_path,
+        size_t max_batch_size = INFERENCE_SERVER_MAX_BATCH_SIZE, size_t max_wait_us = INFERENCE_SERVER_MAX_WAIT_US);
+
+    /**
+     * Destructor for Inference_Server, closing every connection and removing the socket file
+     */
+    ~Inference_Server();
+
+    /* The server owns its sockets, so it can't be copied */
+    Inference_Server(const Inference_Server& target) = delete;
+    Inference_Server& operator=(const Inference_Server& target) = delete;
+
+    /**
+     * Serve requests on the calling thread until stop() is called
+     */
+    void run(void);
+
+    /**
+     * Make run() return after finishing the current batch. Safe to call from any thread or
+     * from a signal handler
+     */
+    void stop(void);
+
+    /**
+     * Get the number of requests answered so far
+     * @returns Returns the number of requests
+     */
+    size_t requests_served(void) const;
+
+    /**
+     * Get the number of inference calls made so far
+     * @returns Returns the number of batches
+     */
+    size_t batches_run(void) const;
+};
+
+};
+
+#endif
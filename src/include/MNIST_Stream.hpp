@@ -0,0 +1,235 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Out-of-core dataset source for image / label IDX pairs too large to hold in memory.
+ * The files are read in fixed-size chunks of images into a bounded pool of buffers, so
+ * peak memory is num_buffers * chunk_images * (MNIST_IMAGE_SIZE + 1) bytes no matter
+ * how many images there are.
+ *
+ * Random access (get_flat, create_images_from_range, ...) follows the same contract as
+ * MNIST_Images / MNIST_Labels and loads chunks on demand, evicting the least recently
+ * used one. Training should use next_batch() instead: each epoch visits the chunks in a
+ * shuffled order, a window of num_buffers chunks at a time, and shuffles the images
+ * across the whole window. That approximates a global shuffle while reading every chunk
+ * exactly once, and the next window is handed to the kernel's readahead while the
+ * current one is consumed. Random access during an epoch is allowed, but any window chunk it
+ * evicts is read again when next_batch() reaches it.
+ *
+ * Pixels stay as bytes in the pool and are normalized when copied out. Not thread safe.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef MNIST_STREAM_HPP
+#define MNIST_STREAM_HPP
+
+/* Default number of images per chunk, 784 KB of pixels */
+#define MNIST_STREAM_CHUNK_IMAGES 1024
+/* Default number of chunk buffers in the pool, which is also the shuffle window */
+#define MNIST_STREAM_BUFFERS 16
+/* Marks a chunk that isn't resident in the pool */
+#define MNIST_STREAM_NOT_LOADED ((size_t)-1)
+
+/* Standard dependencies */
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Local dependencies */
+#include "Log.hpp"
+#include "Matrix.hpp"
+#include "MNIST_Utils.hpp"
+
+namespace MNIST_Stream_NS {
+
+class MNIST_Stream {
+private:
+    /* Private data elements */
+    int m_images_file = -1;
+    int m_labels_file = -1;
+    /* Offsets of the pixel and label data, just past the headers */
+    size_t m_images_offset = 0;
+    size_t m_labels_offset = 0;
+
+    size_t m_num_images = 0;
+    size_t m_chunk_images = 0;
+    size_t m_num_chunks = 0;
+
+    /* Buffer pool: pixels and labels for one chunk per buffer */
+    size_t m_num_buffers = 0;
+    uint8_t* m_pixels = NULL;
+    uint8_t* m_labels = NULL;
+    /* Which chunk each buffer holds, and when it was last used */
+    size_t* m_buffer_chunk = NULL;
+    size_t* m_buffer_used = NULL;
+    size_t m_clock = 0;
+    /* Which buffer each chunk is in, or MNIST_STREAM_NOT_LOADED */
+    size_t* m_chunk_buffer = NULL;
+
+    /* Epoch state for next_batch() */
+    size_t* m_chunk_order = NULL;
+    size_t m_next_chunk = 0;
+    /* Shuffled image indices of the current window */
+    size_t* m_window = NULL;
+    size_t m_window_size = 0;
+    size_t m_window_position = 0;
+
+    /* Grown on demand to the largest batch seen */
+    const uint8_t** m_batch_pixels = NULL;
+    size_t m_batch_capacity = 0;
+
+    /* Private functions */
+
+    /**
+     * Open an IDX file and validate its header
+     * @param path Path to the file
+     * @param magic The expected magic number
+     * @param dimensions Receives the dimensions from the header, magic & 0xFF of them
+     * @param offset Receives the offset of the data
+     * @returns Returns the open file descriptor
+     */
+    int open_idx(const char* path, uint32_t magic, uint32_t* dimensions, size_t* offset);
+
+    /**
+     * Get the buffer holding a chunk, reading it from disk into the least recently used
+     * buffer if it isn't resident
+     * @param chunk The chunk to fetch
+     * @returns Returns the buffer index
+     */
+    size_t load(size_t chunk);
+
+    /**
+     * Number of images in a chunk, which is only short for the last one
+     * @param chunk The chunk
+     * @returns Returns the number of images
+     */
+    size_t chunk_size(size_t chunk) const;
+
+    /**
+     * Load the next window of chunks for next_batch() and shuffle the images across it
+     * @returns Returns false if the epoch has no chunks left
+     */
+    bool next_window(void);
+
+    /**
+     * Get the pixels for an image, loading its chunk if needed
+     * @param index The index of the image
+     * @returns Returns a pointer to MNIST_IMAGE_SIZE bytes, valid until the chunk is evicted
+     */
+    const uint8_t* pixels(size_t index);
+
+    /**
+     * Make sure m_batch_pixels holds at least a number of pointers
+     * @param elements The number of pointers needed
+     */
+    void reserve_batch(size_t elements);
+
+    /**
+     * Write images, given by m_batch_pixels, as normalized columns of destination
+     * @param count Number of images
+     * @param first_column Column of destination the first image goes to
+     * @param destination Matrix with MNIST_IMAGE_SIZE rows
+     */
+    void write_columns(size_t count, size_t first_column, Matrix& destination) const;
+
+public:
+    /* Public functions */
+
+    /**
+     * Open a pair of IDX files for streaming
+     * @param images_path Path to the images file
+     * @param labels_path Path to the matching labels file
+     * @param chunk_images Number of images read from disk at once
+     * @param num_buffers Number of chunks held in memory at once, which is also the shuffle window
+     */
+    MNIST_Stream(const char* images_path, const char* labels_path, size_t chunk_images = MNIST_STREAM_CHUNK_IMAGES,
+        size_t num_buffers = MNIST_STREAM_BUFFERS);
+
+    /**
+     * Destructor for MNIST_Stream, closing the files and releasing the pool
+     */
+    ~MNIST_Stream();
+
+    /* Owns file descriptors and the pool, so it can't be copied */
+    MNIST_Stream(const MNIST_Stream& target) = delete;
+    MNIST_Stream& operator=(const MNIST_Stream& target) = delete;
+
+    /**
+     * Get the number of images in the dataset
+     * @returns Returns the number of images
+     */
+    size_t size(void) const;
+
+    /**
+     * Get the number of bytes the buffer pool holds, which bounds the memory used for data
+     * @returns Returns the size of the pool in bytes
+     */
+    size_t pool_bytes(void) const;
+
+    /**
+     * Get a flattened Matrix representing the image pixels, storing in a preexisting Matrix
+     * @param index The index of the image we want to retrieve
+     * @param destination Reference to a Matrix of MNIST_IMAGE_SIZE elements
+     */
+    void get_flat(size_t index, Matrix& destination);
+
+    /**
+     * Create a Matrix of multiple images combined together, one image per column
+     * @param image_start Start index 
+     * @param image_end End index (exclusive)
+     * @param destination Reference to a Matrix of size MNIST_IMAGE_SIZE x (image_end - image_start)
+     */
+    void create_images_from_range(size_t image_start, size_t image_end, Matrix& destination);
+
+    /**
+     * Get a label at an index
+     * @param index Index to retrieve
+     * @returns Returns the uint8_t label at the index
+     */
+    uint8_t get_label(size_t index);
+
+    /**
+     * Create a Matrix representation of an MNIST label, storing in an existing Matrix
+     * @param index The index of the label to create the Matrix for
+     * @param destination The Matrix to write the result to
+     */
+    void create_label(size_t index, Matrix& destination);
+
+    /**
+     * Create a Matrix representation of multiple labels, one label per column
+     * @param label_start Start index to create labels from
+     * @param label_end End index (exclusive)
+     * @param destination The Matrix to write the result to
+     */
+    void create_labels_from_range(size_t label_start, size_t label_end, Matrix& destination);
+
+    /**
+     * Start a new epoch for next_batch(), shuffling the order the chunks are visited in
+     */
+    void begin_epoch(void);
+
+    /**
+     * Fill the next batch of the epoch with shuffled images and their labels
+     * @param images Matrix of size MNIST_IMAGE_SIZE x batch_size
+     * @param labels Matrix of size MNIST_LABELS x batch_size
+     * @returns Returns true if a full batch was written, false once the epoch is exhausted
+     */
+    bool next_batch(Matrix& images, Matrix& labels);
+};
+
+};
+
+#endif
@@ -8,7 +8,7 @@
  *                                                                                                               
  * Project: Basic Neural Network in C++
  * @author : Samuel Andersen
- * @version: 2025-07-22
+ * @version: 2026-10-17
  *
  * General Notes:
  *
@@ -22,13 +22,32 @@
 #define MNIST_TRAINING_SHOW_LOSS_STEPS 100
 #define MNIST_TRAINING_SHOW_BATCH_LOSS_STEPS 100
 
+/* Background batch loading */
+#define MNIST_TRAINING_LOADER_THREADS 1
+#define MNIST_TRAINING_PIPELINE_SLOTS 4
+
+/* Images per inference call in threaded_predict. The chunk's pixels plus both activation
+ * buffers of a 784-256-... model stay within a 1MB L2 */
+#define MNIST_TRAINING_PREDICT_CHUNK_SIZE 128
+
+/* Untimed single-image inferences run before benchmark_latency starts measuring */
+#define MNIST_TRAINING_LATENCY_WARMUP 1000
+
 /* Standard dependencies */
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <string.h>
 
 /* Local dependencies */
+#include "Batch_Pipeline.hpp"
 #include "Log.hpp"
 #include "Matrix.hpp"
+#include "MNIST_Stream.hpp"
 #include "MNIST_Utils.hpp"
 #include "Neural_Network.hpp"
+#include "Thread_Pool.hpp"
 
 namespace MNIST_Training_NS {
 
@@ -43,11 +62,131 @@ namespace MNIST_Training_NS {
  * @param epochs Number of epochs to run across the entire dataset
  * @param cost_function The cost function to use (quadratic or cross-entropy)
  * @param model_path Path to save the model once it has been run
+ * @param pixel_format Pixel_Format::RAW keeps the dataset as bytes and normalizes inside the first layer,
+ * Pixel_Format::SHARED shares one copy of the float dataset between processes
  */
 void train_new_model(const char* labels_path, const char* images_path, 
     const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t num_training_images, 
+    size_t epochs, Neural_Network_NS::Cost_Function cost_function, const char* model_path,
+    MNIST_Utils_NS::Pixel_Format pixel_format = MNIST_Utils_NS::Pixel_Format::FLOAT);
+
+/**
+ * Train a new model using Hogwild! online training: num_threads threads each take a slice of the
+ * shuffled images and update the shared weights without locks, saving it to a file when it completes
+ * @param labels_path Path to the labels file to read
+ * @param images_path Path to the images file
+ * @param layer_info A reference to std::vector<size_t> containing the number of neurons in each layer
+ * @param learning_rate Learning rate hyperparameter
+ * @param lambda Normalization hyperparameter
+ * @param num_training_images Number of images from the dataset to train on
+ * @param epochs Number of epochs to run across the entire dataset
+ * @param cost_function The cost function to use (quadratic or cross-entropy)
+ * @param num_threads Number of threads training at once
+ * @param model_path Path to save the model once it has been run
+ */
+void hogwild_train_new_model(const char* labels_path, const char* images_path, 
+    const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t num_training_images, 
+    size_t epochs, Neural_Network_NS::Cost_Function cost_function, size_t num_threads, const char* model_path);
+
+/**
+ * Train a new model using (mini)batch training, saving it to a file when it completes
+ * @param labels_path Path to the labels file to read
+ * @param images_path Path to the images file
+ * @param layer_info A reference to std::vector<size_t> containing the number of neurons in each layer
+ * @param learning_rate Learning rate hyperparameter
+ * @param lambda Normalization hyperparameter
+ * @param num_training_images Number of images from the dataset to train on. Any remainder
+ * after dividing by batch_size is skipped
+ * @param batch_size Number of images per batch
+ * @param epochs Number of epochs to run across the entire dataset
+ * @param cost_function The cost function to use (quadratic or cross-entropy)
+ * @param num_threads Number of threads to split each batch across. 1 runs batch_train serially
+ * @param model_path Path to save the model once it has been run
+ * @param pixel_format Pixel_Format::RAW keeps the dataset as bytes and normalizes inside the first layer,
+ * Pixel_Format::SHARED shares one copy of the float dataset between processes.
+ * Only supported with num_threads == 1
+ */
+void batch_train_new_model(const char* labels_path, const char* images_path, 
+    const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t num_training_images, 
+    size_t batch_size, size_t epochs, Neural_Network_NS::Cost_Function cost_function, size_t num_threads,
+    const char* model_path, MNIST_Utils_NS::Pixel_Format pixel_format = MNIST_Utils_NS::Pixel_Format::FLOAT);
+
+/**
+ * Train a new model using (mini)batch training, streaming the dataset from disk through a bounded
+ * buffer pool so it never has to fit in memory, saving it to a file when it completes
+ * @param labels_path Path to the labels file to read
+ * @param images_path Path to the images file
+ * @param layer_info A reference to std::vector<size_t> containing the number of neurons in each layer
+ * @param learning_rate Learning rate hyperparameter
+ * @param lambda Normalization hyperparameter
+ * @param batch_size Number of images per batch
+ * @param epochs Number of epochs to run across the entire dataset
+ * @param cost_function The cost function to use (quadratic or cross-entropy)
+ * @param model_path Path to save the model once it has been run
+ */
+void stream_train_new_model(const char* labels_path, const char* images_path,
+    const std::vector<size_t>& layer_info, float learning_rate, float lambda, size_t batch_size,
     size_t epochs, Neural_Network_NS::Cost_Function cost_function, const char* model_path);
 
+/**
+ * Calculate the fraction of images a Neural Network classifies correctly
+ * @param nn The Neural Network to check
+ * @param images The images to run inference on
+ * @param labels The expected labels
+ * @param num_images Number of images to check, starting from the first
+ * @returns Returns the accuracy in [0, 1]
+ */
+float calculate_accuracy(const Neural_Network_NS::Neural_Network& nn, const MNIST_Utils_NS::MNIST_Images& images,
+    const MNIST_Utils_NS::MNIST_Labels& labels, size_t num_images);
+
+/**
+ * Count how many images a Neural Network classifies correctly, spread across threads. The images
+ * are split into MNIST_TRAINING_PREDICT_CHUNK_SIZE chunks that each run as one batched inference
+ * call, and threads that run out of chunks steal from the others
+ * @param nn The Neural Network to check, shared by every thread
+ * @param images The images to run inference on
+ * @param labels The expected labels
+ * @param num_images Number of images to check, starting from the first
+ * @param num_threads Number of threads to run on, including the caller
+ * @returns Returns the number of images classified correctly
+ */
+size_t threaded_predict(const Neural_Network_NS::Neural_Network& nn, const MNIST_Utils_NS::MNIST_Images& images,
+    const MNIST_Utils_NS::MNIST_Labels& labels, size_t num_images, size_t num_threads);
+
+/**
+ * Load a model and a dataset, then log how many of the images the model classifies correctly
+ * @param labels_path Path to the labels file to read
+ * @param images_path Path to the images file
+ * @param num_images Number of images to predict, starting from the first
+ * @param model_path Path to the model to load
+ * @param num_threads Number of threads to run on, including the caller
+ */
+void predict_model(const char* labels_path, const char* images_path, size_t num_images, const char* model_path,
+    size_t num_threads);
+
+/**
+ * Time single-image inference, one image per call as on an interactive path, and print the
+ * median, p99 and mean latency in microseconds
+ * @param images_path Path to the images file to cycle through
+ * @param model_path Path to the model to load
+ * @param iterations Number of timed inferences
+ */
+void benchmark_latency(const char* images_path, const char* model_path, size_t iterations);
+
+/**
+ * Log the throughput and training set accuracy once training has finished, so the different
+ * trainers can be compared
+ * @param caller Name of the trainer, used in the log messages
+ * @param nn The trained Neural Network
+ * @param images The training images
+ * @param labels The training labels
+ * @param images_trained Total number of images processed across all epochs
+ * @param seconds Wall time spent training
+ */
+void report_training(const char* caller, const Neural_Network_NS::Neural_Network& nn,
+    const MNIST_Utils_NS::MNIST_Images& images, const MNIST_Utils_NS::MNIST_Labels& labels,
+    size_t images_trained, double seconds);
+
 /**
  * Shuffle the indicies used for pulling images and labels
  * See Fisher-Yates Shuffle: https://en.wikipedia.org/wiki/Fisher%E2%80%93Yates_shuffle
@@ -63,6 +202,16 @@ void shuffle(size_t* index, size_t elements);
  */
 size_t* create_index_array(size_t elements);
 
+/**
+ * Create the order the trainers visit elements in across every epoch: each epoch is a fresh
+ * shuffle of [0, elements), of which the first per_epoch entries are kept
+ * @param elements Number of elements to shuffle
+ * @param per_epoch Number of entries to keep per epoch
+ * @param epochs Number of epochs
+ * @returns Returns an array of per_epoch * epochs indices, to be freed by the caller
+ */
+size_t* create_schedule(size_t elements, size_t per_epoch, size_t epochs);
+
 
 };
 
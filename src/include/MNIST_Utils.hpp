@@ -22,6 +22,9 @@
 /* General config */
 #define MNIST_UTILS_DEBUG 1
 
+/* IDX files have at most this many dimensions (images have 3: count, height, width) */
+#define IDX_FILE_MAX_DIMENSIONS 4
+
 /* MNIST_Lables config */
 #define MNIST_LABEL_MAGIC 0x00000801
 #define MNIST_LABELS 10
@@ -31,29 +34,179 @@
 #define MNIST_IMAGE_WIDTH 28
 #define MNIST_IMAGE_HEIGHT 28
 #define MNIST_IMAGE_SIZE MNIST_IMAGE_WIDTH * MNIST_IMAGE_HEIGHT
+/* Alignment of the image store. 28 * 28 floats is exactly 49 cache lines, so every image starts aligned */
+#define MNIST_IMAGES_ALIGNMENT 64
+/* Stores at least this large are aligned to (and advised as) transparent huge pages */
+#define MNIST_IMAGES_HUGE_PAGE (2 * 1024 * 1024)
+/* Number of images transposed side by side when building batch columns */
+#define MNIST_IMAGES_TRANSPOSE_BLOCK 64
+/* Gathers of at least this many images are split across a Thread_Pool when one is given */
+#define MNIST_IMAGES_GATHER_PARALLEL_MIN 1024
+/* Float images are cached next to the IDX file so later runs can map them instead of decoding */
+#define MNIST_IMAGES_USE_CACHE 1
+#define MNIST_IMAGES_CACHE_SUFFIX ".cache"
+#define MNIST_IMAGES_CACHE_MAGIC 0x46434E4D
+#define MNIST_IMAGES_CACHE_VERSION 1
+/* The pixels start this far into the cache file, so they are page (and cache line) aligned */
+#define MNIST_IMAGES_CACHE_HEADER_SIZE 4096
+/* Checksum the cached pixels on every load, not just the header. Touches the whole file */
+#define MNIST_IMAGES_CACHE_VERIFY 0
+/* Prefix of the POSIX shared memory segments used by Pixel_Format::SHARED */
+#define MNIST_IMAGES_SHARED_PREFIX "/mnist_images_"
 
 /* Standard dependencies */
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /* Local dependencies */
 #include "Matrix.hpp"
+#include "Matrix_Kernels.hpp"
 #include "Log.hpp"
+#include "Thread_Pool.hpp"
 
 /* Using */
 using Matrix = Matrix_NS::Matrix<float>;
+using Byte_Matrix = Matrix_NS::Matrix<uint8_t>;
 
 namespace MNIST_Utils_NS {
 
+typedef enum {
+    /* Pixels are converted to floats in [0, 1] when loading */
+    FLOAT,
+    /* Pixels stay as the raw bytes from the file, which are mapped rather than copied */
+    RAW,
+    /* Pixels are converted to floats once per machine and published in POSIX shared memory,
+       which every process loading the same file maps read-only */
+    SHARED
+} Pixel_Format;
+
+/**
+ * Header at the start of an image cache file. Written in host byte order, so a cache from a
+ * machine with the other endianness fails the magic check and is rebuilt
+ */
+struct MNIST_Images_Cache_Header {
+    uint32_t magic;
+    uint32_t version;
+    /* Identity of the IDX file the cache was built from */
+    uint64_t source_size;
+    int64_t source_mtime_sec;
+    int64_t source_mtime_nsec;
+    uint64_t num_images;
+    /* Bytes of float pixels following the header */
+    uint64_t payload_size;
+    uint64_t payload_checksum;
+    /* Checksum of every field above */
+    uint64_t header_checksum;
+};
+
+/**
+ * Read-only memory mapping of an IDX file (the format the MNIST dataset ships in), with the
+ * header validated and the payload exposed in place
+ */
+class IDX_File {
+private:
+    /* Private data elements */
+    void* m_mapping = NULL;
+    size_t m_mapping_size = 0;
+    const uint8_t* m_payload = NULL;
+    size_t m_num_dimensions = 0;
+    size_t m_dimensions[IDX_FILE_MAX_DIMENSIONS] = {0, 0, 0, 0};
+
+public:
+    /* Public functions */
+
+    /**
+     * Map an IDX file and validate its header. Exits if the file can't be mapped, the magic
+     * number doesn't match or the file is shorter than the header says
+     * @param path Path to the IDX file
+     * @param magic The magic number expected, which also encodes the number of dimensions
+     */
+    IDX_File(const char* path, uint32_t magic);
+
+    /**
+     * Destructor for IDX_File, unmapping the file
+     */
+    ~IDX_File();
+
+    /* The mapping is released on destruction, so it can't be copied */
+    IDX_File(const IDX_File& target) = delete;
+    IDX_File& operator=(const IDX_File& target) = delete;
+
+    /**
+     * Get the size of one of the dimensions from the header
+     * @param index Which dimension, 0 being the number of items
+     * @returns Returns the size of the dimension
+     */
+    size_t dimension(size_t index) const;
+
+    /**
+     * Get the number of items in the file
+     * @returns Returns the first dimension
+     */
+    size_t count(void) const;
+
+    /**
+     * Get the number of bytes in each item, i.e. the product of the remaining dimensions
+     * @returns Returns the item size in bytes
+     */
+    size_t item_size(void) const;
+
+    /**
+     * Get the data following the header
+     * @returns Returns a pointer to count() * item_size() bytes, valid while IDX_File lives
+     */
+    const uint8_t* payload(void) const;
+};
+
 class MNIST_Images {
 private:
     /* Private data elements */
     size_t m_num_images = 0;
-    Matrix** m_images = NULL;
+    Pixel_Format m_format = Pixel_Format::FLOAT;
+    /* Only kept for Pixel_Format::RAW, where the pixels are read straight from the mapping */
+    IDX_File* m_file = NULL;
+    /* Every image back to back in one aligned buffer: image i is MNIST_IMAGE_SIZE floats at i * MNIST_IMAGE_SIZE */
+    float* m_images = NULL;
+    /* Set when m_images points into a mapped cache file or shared segment rather than an allocation */
+    void* m_cache_mapping = NULL;
+    size_t m_cache_mapping_size = 0;
 
     /* Private functions */
 
+    /**
+     * Map the float cache for an IDX file, if it exists and was built from the file as it is now
+     * @param cache_path Path to the cache file
+     * @param source stat() of the IDX file
+     * @returns True if the cache was valid and m_images now points into it, false otherwise
+     */
+    bool map_cache(const char* cache_path, const struct stat& source);
+
+    /**
+     * Write m_images out as the float cache for an IDX file. The cache is written to a temporary
+     * file and renamed into place, so concurrent runs never see a partial cache. Failing to
+     * write it is only a warning
+     * @param cache_path Path to the cache file
+     * @param source stat() of the IDX file
+     */
+    void write_cache(const char* cache_path, const struct stat& source) const;
+
+    /**
+     * Map the shared memory segment for an IDX file read-only, building and publishing it first
+     * if no other process has
+     * @param path Path to the IDX file
+     * @returns True if m_images now points into the segment, false if shared memory is unavailable
+     */
+    bool attach_shared(const char* path);
+
     /**
      * Check to see that a given index exists and is valid (not NULL)
      * @param index Index to check
@@ -67,26 +220,86 @@ public:
     /**
      * Constructor for MNIST_Images
      * @param path Path to file containing the MNIST image collection
+     * @param format Whether to convert the pixels to floats or keep the raw bytes. The float
+     * accessors are only available for Pixel_Format::FLOAT and Pixel_Format::SHARED, and raw()
+     * only for Pixel_Format::RAW.
+     * Float images are mapped from path + MNIST_IMAGES_CACHE_SUFFIX when it is up to date, and
+     * the cache is (re)built otherwise
      */
-    MNIST_Images(const char* path);
+    MNIST_Images(const char* path, Pixel_Format format = Pixel_Format::FLOAT);
 
     /**
      * Destructor for MNIST_Images
      */
     ~MNIST_Images();
 
+    /**
+     * Remove the shared memory segment for an IDX file, e.g. once a sweep has finished. Processes
+     * that have it mapped keep their mapping
+     * @param path Path to the IDX file
+     * @returns Returns true if a segment was removed
+     */
+    static bool remove_shared(const char* path);
+
     /**
      * Get the number of images contained in MNIST_Images
      * @returns Returns a size_t of the number of images contained
      */
     size_t size(void) const;
 
+    /* The views handed out point into the store, so it can't be copied */
+    MNIST_Images(const MNIST_Images& target) = delete;
+    MNIST_Images& operator=(const MNIST_Images& target) = delete;
+
+    /**
+     * Get a MNIST_IMAGE_HEIGHT x MNIST_IMAGE_WIDTH view of the image's pixels at an index
+     * @param index The number of the image we want to fetch
+     * @returns Returns a Matrix view into the store, valid while MNIST_Images lives
+     */
+    const Matrix get(size_t index) const;
+
     /**
-     * Get the Matrix representing the image's pixels at an index
-     * @param index The number of the image / Matrix we want to fetch
-     * @returns Returns a constant reference to the underlying image data
+     * Get the format the pixels were loaded in
+     * @returns Returns the Pixel_Format
      */
-    const Matrix& get(size_t index) const;
+    Pixel_Format format(void) const;
+
+    /**
+     * Get a pointer to the raw pixel bytes of an image, as stored in the file
+     * @param index The index of the image
+     * @returns Returns a pointer to MNIST_IMAGE_SIZE bytes, valid while MNIST_Images lives
+     */
+    const uint8_t* raw(size_t index) const;
+
+    /**
+     * Get a flattened MNIST_IMAGE_SIZE x 1 view of an image's raw pixels, without copying
+     * @param index The index of the image
+     * @returns Returns a column Byte_Matrix view into the mapping, valid while MNIST_Images lives
+     */
+    const Byte_Matrix view_raw(size_t index) const;
+
+    /**
+     * Get a pointer to the pixels of an image
+     * @param index The index of the image
+     * @returns Returns a pointer to MNIST_IMAGE_SIZE floats, aligned to MNIST_IMAGES_ALIGNMENT
+     */
+    const float* data(size_t index) const;
+
+    /**
+     * Get a flattened MNIST_IMAGE_SIZE x 1 view of an image, without copying
+     * @param index The index of the image
+     * @returns Returns a column Matrix view into the store, valid while MNIST_Images lives
+     */
+    const Matrix view(size_t index) const;
+
+    /**
+     * Get a view of a range of images without copying. The store is image-major, so the
+     * view holds one image per row, i.e. it is the transpose of create_images_from_range()
+     * @param image_start Start index
+     * @param image_end End index (exclusive)
+     * @returns Returns a (image_end - image_start) x MNIST_IMAGE_SIZE Matrix view into the store
+     */
+    const Matrix view_range(size_t image_start, size_t image_end) const;
 
     /**
      * Get a flattened Matrix representing the image pixels
@@ -119,6 +332,37 @@ public:
      * @param destination Reference to a Matrix to store the result in
      */
     void create_images_from_range(size_t image_start, size_t image_end, Matrix& destination) const;
+
+    /**
+     * Create a Byte_Matrix of the raw pixels of multiple images, one image per column.
+     * Only available for Pixel_Format::RAW
+     * @param image_start Start index 
+     * @param image_end End index
+     * @param destination Reference to a Byte_Matrix of size MNIST_IMAGE_SIZE x (image_end - image_start)
+     */
+    void create_images_from_range(size_t image_start, size_t image_end, Byte_Matrix& destination) const;
+
+    /**
+     * Gather arbitrary images into a preallocated Matrix, one image per column, useful for
+     * shuffled batch training. Upcoming images are prefetched while the current ones are copied
+     * @param indices Indices of the images to gather, in column order
+     * @param num_indices Number of indices
+     * @param destination Reference to a Matrix of size MNIST_IMAGE_SIZE x num_indices
+     * @param pool Optional Thread_Pool to split large gathers across
+     */
+    void gather_images(const size_t* indices, size_t num_indices, Matrix& destination,
+        Thread_Pool_NS::Thread_Pool* pool = NULL) const;
+
+    /**
+     * Gather the raw pixels of arbitrary images into a preallocated Byte_Matrix, one image per
+     * column. Only available for Pixel_Format::RAW
+     * @param indices Indices of the images to gather, in column order
+     * @param num_indices Number of indices
+     * @param destination Reference to a Byte_Matrix of size MNIST_IMAGE_SIZE x num_indices
+     * @param pool Optional Thread_Pool to split large gathers across
+     */
+    void gather_images(const size_t* indices, size_t num_indices, Byte_Matrix& destination,
+        Thread_Pool_NS::Thread_Pool* pool = NULL) const;
 };
 
 class MNIST_Labels {
@@ -193,6 +437,15 @@ public:
      * @param destination The Matrix to write the result to
      */
     void create_labels_from_range(size_t label_start, size_t label_end, Matrix& destination) const;
+
+    /**
+     * Gather arbitrary labels into a preallocated Matrix, one label per column, useful for
+     * shuffled batch training
+     * @param indices Indices of the labels to gather, in column order
+     * @param num_indices Number of indices
+     * @param destination The Matrix of size MNIST_LABELS x num_indices to write the result to
+     */
+    void gather_labels(const size_t* indices, size_t num_indices, Matrix& destination) const;
 };
 
 /**
@@ -8,7 +8,7 @@
  *                                                                                                               
  * Project: Basic Neural Network in C++
  * @author : Samuel Andersen
- * @version: 2025-07-19
+ * @version: 2026-10-17
  *
  * General Notes:
  *
@@ -25,9 +25,13 @@
 #include <iostream>
 #include <string.h>
 #include <math.h>
+#include <type_traits>
 
 /* Local dependencies */
+#include "Allocation_Counter.hpp"
 #include "Log.hpp"
+#include "Matrix_GEMM.hpp"
+#include "Matrix_Kernels.hpp"
 
 /* Definitions */
 
@@ -50,6 +54,8 @@ private:
     Matrix_Type* m_data = NULL;
     size_t m_num_rows = 0;
     size_t m_num_cols = 0;
+    /* False for views onto memory owned by someone else, e.g. a workspace arena */
+    bool m_owns_data = true;
 
     /* Helper functions that aren't ever used publicly */
 
@@ -78,7 +84,8 @@ private:
     /**
      * Perform a generic operation on all elements of a source and
      * a target Matrix, storing in a specified destination. This function should
-     * only be called after validating sizes match properly
+     * only be called after validating sizes match properly. The destination may
+     * be the calling Matrix or the target
      * @param target Matrix to perform the operation with
      * @param destination Destination Matrix for the result
      * @param operation The operation to perform
@@ -86,28 +93,51 @@ private:
     void element_op(const Matrix<Matrix_Type>& target, Matrix<Matrix_Type>& destination,
         Element_Operations operation) const {
 
-        if (operation == Element_Operations::ADD) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                destination.m_data[i] = m_data[i] + target.m_data[i];
+        const size_t elements = rows() * cols();
+
+        /* float Matrix instances go through the SIMD kernels picked for this CPU */
+        if constexpr (std::is_same_v<Matrix_Type, float>) {
+            const Matrix_Kernels_NS::Kernel_Table& kernels = Matrix_Kernels_NS::kernels();
+
+            if (operation == Element_Operations::ADD) {
+                kernels.add(m_data, target.m_data, destination.m_data, elements);
+                return;
             }
-        }
-        else if (operation == Element_Operations::SUBTRACT) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                destination.m_data[i] = m_data[i] - target.m_data[i];
+            else if (operation == Element_Operations::SUBTRACT) {
+                kernels.subtract(m_data, target.m_data, destination.m_data, elements);
+                return;
             }
-        }
-        else if (operation == Element_Operations::MULTIPLY) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                destination.m_data[i] = m_data[i] * target.m_data[i];
+            else if (operation == Element_Operations::MULTIPLY) {
+                kernels.multiply(m_data, target.m_data, destination.m_data, elements);
+                return;
             }
         }
         else {
-            Log::log_message(Log::Log_Priority::ERROR, "Matrix::element_op",
-                "Invalid element operation provided");
+            if (operation == Element_Operations::ADD) {
+                for (size_t i = 0; i < elements; ++i) {
+                    destination.m_data[i] = m_data[i] + target.m_data[i];
+                }
+                return;
+            }
+            else if (operation == Element_Operations::SUBTRACT) {
+                for (size_t i = 0; i < elements; ++i) {
+                    destination.m_data[i] = m_data[i] - target.m_data[i];
+                }
+                return;
+            }
+            else if (operation == Element_Operations::MULTIPLY) {
+                for (size_t i = 0; i < elements; ++i) {
+                    destination.m_data[i] = m_data[i] * target.m_data[i];
+                }
+                return;
+            }
         }
-     }
 
-     /**
+        Log::log_message(Log::Log_Priority::ERROR, "Matrix::element_op",
+            "Invalid element operation provided");
+    }
+
+    /**
      * Perform a generic operation on all elements of a source and
      * a target Matrix, overwriting the calling Matrix. This function should
      * only be called after validating sizes match properly
@@ -116,26 +146,62 @@ private:
      */
     void element_op(const Matrix<Matrix_Type>& target, Element_Operations operation) {
 
-        if (operation == Element_Operations::ADD) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                m_data[i] += target.m_data[i];
+        element_op(target, *this, operation);
+    }
+
+    /**
+     * Perform a generic operation on all elements of a Matrix with a scalar value, storing
+     * in a specified destination. This function should only be called after validating
+     * sizes match properly. The destination may be the calling Matrix
+     * @param value The value to be applied
+     * @param destination Destination Matrix for the result
+     * @param operation The operation to perform
+     */
+    void element_op(Matrix_Type value, Matrix<Matrix_Type>& destination, Element_Operations operation) const {
+
+        const size_t elements = rows() * cols();
+
+        if constexpr (std::is_same_v<Matrix_Type, float>) {
+            const Matrix_Kernels_NS::Kernel_Table& kernels = Matrix_Kernels_NS::kernels();
+
+            if (operation == Element_Operations::ADD) {
+                kernels.add_scalar(m_data, value, destination.m_data, elements);
+                return;
             }
-        }
-        else if (operation == Element_Operations::SUBTRACT) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                m_data[i] -= target.m_data[i];
+            else if (operation == Element_Operations::SUBTRACT) {
+                // IEEE subtraction is defined as adding the negation, so this is exact
+                kernels.add_scalar(m_data, -value, destination.m_data, elements);
+                return;
             }
-        }
-        else if (operation == Element_Operations::MULTIPLY) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                m_data[i] *= target.m_data[i];
+            else if (operation == Element_Operations::MULTIPLY) {
+                kernels.scale(m_data, value, destination.m_data, elements);
+                return;
             }
         }
         else {
-            Log::log_message(Log::Log_Priority::ERROR, "Matrix::element_op",
-                "Invalid element operation provided");
+            if (operation == Element_Operations::ADD) {
+                for (size_t i = 0; i < elements; ++i) {
+                    destination.m_data[i] = m_data[i] + value;
+                }
+                return;
+            }
+            else if (operation == Element_Operations::SUBTRACT) {
+                for (size_t i = 0; i < elements; ++i) {
+                    destination.m_data[i] = m_data[i] - value;
+                }
+                return;
+            }
+            else if (operation == Element_Operations::MULTIPLY) {
+                for (size_t i = 0; i < elements; ++i) {
+                    destination.m_data[i] = m_data[i] * value;
+                }
+                return;
+            }
         }
-     }
+
+        Log::log_message(Log::Log_Priority::ERROR, "Matrix::element_op",
+            "Invalid element operation provided");
+    }
 
     /**
      * Perform a generic operation on all elements of a Matrix, overwriting the calling
@@ -145,47 +211,68 @@ private:
      */
     void element_op(Matrix_Type value, Element_Operations operation) {
 
-        if (operation == Element_Operations::ADD) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                m_data[i] += value;
-            }
-        }
-        else if (operation == Element_Operations::SUBTRACT) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                m_data[i] -= value;
-            }
-        }
-        else if (operation == Element_Operations::MULTIPLY) {
-            for (size_t i = 0; i < rows() * cols(); ++i) {
-                m_data[i] *= value;
-            }
-        }
-        else {
-            Log::log_message(Log::Log_Priority::ERROR, "Matrix::element_op",
-                "Invalid element operation provided");
+        element_op(value, *this, operation);
+    }
+
+    /**
+     * Apply a function to a Matrix, overwriting the caller. Any callable works here;
+     * lambdas and functors are inlined into the loop, letting the compiler vectorize it
+     * @param func Function to apply, this function must return a value of type Matrix_Type
+     */
+    template <typename Function> void apply_fn(Function func) {
+
+        const size_t elements = rows() * cols();
+
+        for (size_t i = 0; i < elements; ++i) {
+            m_data[i] = func(m_data[i]);
         }
     }
 
     /**
-     * Apply a function to a Matrix, overwriting the caller
+     * Apply a function to a Matrix, writing the results to a destination. This function
+     * should only be called after validating sizes match properly
      * @param func Function to apply, this function must return a value of type Matrix_Type
+     * @param destination Destination Matrix for the result
      */
-    void apply_fn(Matrix_Type (*func)(Matrix_Type)) {
+    template <typename Function> void apply_fn(Function func, Matrix<Matrix_Type>& destination) const {
 
-        for (size_t i = 0; i < rows() * cols(); ++i) {
-            m_data[i] = (*func)(m_data[i]);
+        const size_t elements = rows() * cols();
+        const Matrix_Type* source = m_data;
+        Matrix_Type* target = destination.m_data;
+
+        for (size_t i = 0; i < elements; ++i) {
+            target[i] = func(source[i]);
         }
     }
 
     /**
-     * Apply a function to a MAtrix, overwriting the caller
+     * Apply a function to a single row or column of a Matrix, overwriting the caller
      * @param func Function to apply, this function must return a value of type Matrix_Type
-     * @param param Additional parameter to be passed to func, must be of type Matrix_Type
+     * @param orientation Either ROW or COLUMN
+     * @param index Index of the row or column
+     * @param caller Function this is being called from
      */
-    void apply_fn(Matrix_Type (*func)(Matrix_Type, Matrix_Type), Matrix_Type param) {
+    template <typename Function> void apply_vector_fn(Function func, Vector_Orientation orientation,
+        size_t index, const char* caller) {
 
-        for (size_t i = 0; i < rows() * cols (); ++i) {
-            m_data[i] = (*func)(m_data[i], param);
+        if (orientation == Vector_Orientation::ROW) {
+            if (!exists(index, 0)) {
+                Log::log_message(Log::Log_Priority::ERROR, caller, "Invalid index provided");
+                exit(EXIT_FAILURE);
+            }
+            Matrix_Type* row = m_data + (index * cols());
+            for (size_t i = 0; i < cols(); ++i) {
+                row[i] = func(row[i]);
+            }
+        }
+        else {
+            if (!exists(0, index)) {
+                Log::log_message(Log::Log_Priority::ERROR, caller, "Invalid index provided");
+                exit(EXIT_FAILURE);
+            }
+            for (size_t i = 0; i < rows(); ++i) {
+                m_data[(i * cols()) + index] = func(m_data[(i * cols()) + index]);
+            }
         }
     }
 
@@ -231,6 +318,57 @@ private:
         return true;
     }
 
+    /**
+     * Compute op(this) * op(target), where op() optionally transposes its operand. The
+     * transpose is never materialized, it is handled by passing swapped strides to the GEMM
+     * @param target Right hand side of the product
+     * @param destination Destination Matrix for the result
+     * @param transpose_self True to use the transpose of the calling Matrix
+     * @param transpose_target True to use the transpose of target
+     * @param caller Function this is being called from
+     * @param target_scale Factor applied to target when it holds another type than Matrix_Type
+     */
+    template <typename Target_Type>
+    void dot_op(const Matrix<Target_Type>& target, Matrix<Matrix_Type>& destination,
+        bool transpose_self, bool transpose_target, const char* caller, Matrix_Type target_scale = 1) const {
+
+        size_t m = transpose_self ? cols() : rows();
+        size_t k = transpose_self ? rows() : cols();
+        size_t target_k = transpose_target ? target.cols() : target.rows();
+        size_t n = transpose_target ? target.rows() : target.cols();
+
+        if (k != target_k) {
+            Log::log_message(Log::Log_Priority::ERROR, caller,
+                "Matrix dimension mismatch. Cannot calculate the dot product");
+
+            if (MATRIX_DEBUG) {
+                Log::log_message(Log::Log_Priority::DEBUG, caller,
+                    std::format("First operand is [{} x {}], second is [{} x {}]",
+                        m, k, target_k, n));
+            }
+            exit(EXIT_FAILURE);
+        }
+
+        if (destination.rows() != m || destination.cols() != n) {
+            Log::log_message(Log::Log_Priority::ERROR, caller,
+                "Destination Matrix has the wrong dimensions");
+
+            if (MATRIX_DEBUG) {
+                Log::log_message(Log::Log_Priority::DEBUG, caller,
+                    std::format("Destination Matrix is [{} x {}], but should be [{} x {}]",
+                        destination.rows(), destination.cols(), m, n));
+            }
+            exit(EXIT_FAILURE);
+        }
+
+        // Row-major storage: element (i, j) lives at i * cols() + j. Reading the transpose
+        // just swaps which of the two strides walks rows and which walks columns
+        Matrix_GEMM_NS::gemm(m, n, k,
+            m_data, transpose_self ? 1 : cols(), transpose_self ? cols() : 1,
+            target.data(), transpose_target ? 1 : target.cols(), transpose_target ? target.cols() : 1,
+            destination.m_data, destination.cols(), false, target_scale);
+    }
+
 public:
     /* Public functions */
     
@@ -246,18 +384,58 @@ public:
         m_num_cols = num_cols;
         /* Allocate memory for data storage */
         m_data = (Matrix_Type*)calloc(num_rows * num_cols, sizeof(Matrix_Type));
+        Allocation_Counter_NS::record();
         /* Zero out the memory manually, to be safe */
         memset(m_data, '\0', num_cols * num_rows * sizeof(Matrix_Type));
     }
 
+    /**
+     * Create a Matrix that views existing memory instead of allocating its own. The memory
+     * is not freed when the Matrix is destroyed and must outlive it
+     * @param num_rows Number of rows
+     * @param num_cols Number of colums
+     * @param data Pointer to at least num_rows * num_cols elements, stored row-major
+     * @returns Returns a new Matrix view
+     */
+    Matrix(size_t num_rows, size_t num_cols, Matrix_Type* data) {
+
+        m_num_rows = num_rows;
+        m_num_cols = num_cols;
+        m_data = data;
+        m_owns_data = false;
+    }
+
+    /* A copy would share m_data and free it twice, use clone() or copy_to() instead */
+    Matrix(const Matrix<Matrix_Type>& target) = delete;
+    Matrix<Matrix_Type>& operator=(const Matrix<Matrix_Type>& target) = delete;
+
     /**
      * Destructor for Matrix
      */
     ~Matrix() {
-        if (m_data != NULL) { 
+        if (m_data != NULL && m_owns_data) { 
             free(m_data);
-            m_data = NULL;
         }
+        m_data = NULL;
+    }
+
+    /**
+     * Point a Matrix view at different memory and / or dimensions. Only valid for views
+     * @param num_rows Number of rows
+     * @param num_cols Number of colums
+     * @param data Pointer to at least num_rows * num_cols elements, stored row-major
+     */
+    void rebind(size_t num_rows, size_t num_cols, Matrix_Type* data) {
+
+        if (m_owns_data) {
+            Log::log_message(Log::Log_Priority::ERROR, "Matrix::rebind",
+                "Cannot rebind a Matrix that owns its data");
+            exit(EXIT_FAILURE);
+        }
+
+        m_num_rows = num_rows;
+        m_num_cols = num_cols;
+        m_data = data;
     }
 
     /**
@@ -284,6 +462,22 @@ public:
         return sizeof(Matrix_Type) * rows() * cols();
     }
 
+    /**
+     * Get the underlying row-major data, e.g. to hand to an array kernel
+     * @returns Returns a pointer to m_data
+     */
+    Matrix_Type* data(void) {
+        return m_data;
+    }
+
+    /**
+     * Get the underlying row-major data, e.g. to hand to an array kernel
+     * @returns Returns a const pointer to m_data
+     */
+    const Matrix_Type* data(void) const {
+        return m_data;
+    }
+
     /**
      * Check whether the index provided is valid for the Matrix
      * @param target_row Row to check
@@ -523,19 +717,89 @@ public:
             exit(EXIT_FAILURE);
         }
 
-        Matrix_Type sum = 0;
+        /* Hand off to the blocked GEMM. All three Matrix instances are row-major */
+        Matrix_GEMM_NS::gemm(rows(), target.cols(), cols(),
+            m_data, cols(), 1,
+            target.m_data, target.cols(), 1,
+            destination.m_data, destination.cols(), false);
+    }
 
-        /* Iterate over the expected rows of the new Matrix */
-        for (size_t i = 0; i < destination.rows(); ++i) {
-            for (size_t j = 0; j < destination.cols(); ++j) {
-                /* Sum the multiplications of the elements from self + target */
-                for (size_t k = 0; k < cols(); ++k) {
-                    sum += get(i, k) * target.get(k, j);
-                }
-                destination.set(i, j, sum);
-                sum = 0;
-            }
-        }
+    /**
+     * Compute the dot product of the transpose of the calling Matrix with another Matrix,
+     * without materializing the transpose
+     * @param target Matrix to calculate the dot product with
+     * @returns Returns a new Matrix instance with the result of (this^T * target)
+     */
+    Matrix<Matrix_Type>* dot_tn(const Matrix<Matrix_Type>& target) const {
+
+        Matrix<Matrix_Type>* result = new Matrix<Matrix_Type>(cols(), target.cols());
+        dot_op(target, *result, true, false, "Matrix::dot_tn");
+        return result;
+    }
+
+    /**
+     * Compute the dot product of the transpose of the calling Matrix with another Matrix,
+     * saving the result to an existing Matrix
+     * @param target Matrix to calculate the dot product with
+     * @param destination Destination Matrix, of size [this->cols() x target.cols()]
+     */
+    void dot_tn(const Matrix<Matrix_Type>& target, Matrix<Matrix_Type>& destination) const {
+
+        dot_op(target, destination, true, false, "Matrix::dot_tn");
+    }
+
+    /**
+     * Compute the dot product of the calling Matrix with the transpose of another Matrix,
+     * without materializing the transpose
+     * @param target Matrix whose transpose we calculate the dot product with
+     * @returns Returns a new Matrix instance with the result of (this * target^T)
+     */
+    Matrix<Matrix_Type>* dot_nt(const Matrix<Matrix_Type>& target) const {
+
+        Matrix<Matrix_Type>* result = new Matrix<Matrix_Type>(rows(), target.rows());
+        dot_op(target, *result, false, true, "Matrix::dot_nt");
+        return result;
+    }
+
+    /**
+     * Compute the dot product of the calling Matrix with the transpose of another Matrix,
+     * saving the result to an existing Matrix
+     * @param target Matrix whose transpose we calculate the dot product with
+     * @param destination Destination Matrix, of size [this->rows() x target.rows()]
+     */
+    void dot_nt(const Matrix<Matrix_Type>& target, Matrix<Matrix_Type>& destination) const {
+
+        dot_op(target, destination, false, true, "Matrix::dot_nt");
+    }
+
+    /**
+     * Compute the dot product with a Matrix of a narrower type (e.g. uint8_t pixels), scaling its
+     * elements by target_scale. The conversion happens inside the GEMM, so no wide copy of target is made
+     * @param target Matrix to calculate the dot product with
+     * @param target_scale Factor applied to every element of target
+     * @param destination Destination Matrix, of size [this->rows() x target.cols()]
+     */
+    template <typename Target_Type>
+    void dot_scaled(const Matrix<Target_Type>& target, Matrix_Type target_scale, Matrix<Matrix_Type>& destination) const {
+
+        static_assert(!std::is_same_v<Target_Type, Matrix_Type>, "Same-type operands aren't scaled, use dot()");
+
+        dot_op(target, destination, false, false, "Matrix::dot_scaled", target_scale);
+    }
+
+    /**
+     * Compute the dot product of the calling Matrix with the transpose of a Matrix of a narrower
+     * type, scaling its elements by target_scale
+     * @param target Matrix whose transpose we calculate the dot product with
+     * @param target_scale Factor applied to every element of target
+     * @param destination Destination Matrix, of size [this->rows() x target.rows()]
+     */
+    template <typename Target_Type>
+    void dot_nt_scaled(const Matrix<Target_Type>& target, Matrix_Type target_scale, Matrix<Matrix_Type>& destination) const {
+
+        static_assert(!std::is_same_v<Target_Type, Matrix_Type>, "Same-type operands aren't scaled, use dot_nt()");
+
+        dot_op(target, destination, false, true, "Matrix::dot_nt_scaled", target_scale);
     }
 
     /**
@@ -586,8 +850,15 @@ public:
      */
     void populate(Matrix_Type value) {
 
-        for (size_t i = 0; i < rows() * cols(); ++i) {
-            m_data[i] = value;
+        const size_t elements = rows() * cols();
+
+        if constexpr (std::is_same_v<Matrix_Type, float>) {
+            Matrix_Kernels_NS::kernels().fill(m_data, value, elements);
+        }
+        else {
+            for (size_t i = 0; i < elements; ++i) {
+                m_data[i] = value;
+            }
         }
     }
 
@@ -675,6 +946,37 @@ public:
         element_op(target, Element_Operations::ADD);
     }
 
+    /**
+     * Add a column vector to every column of this Matrix, e.g. a bias to a batch of outputs
+     * @param target Matrix of dimension [rows x 1] to add
+     */
+    void broadcast_add_o(const Matrix<Matrix_Type>& target) {
+
+        if (target.rows() != rows() || target.cols() != 1) {
+            Log::log_message(Log::Log_Priority::ERROR, "Matrix::broadcast_add_o",
+                "Target must be a column vector with the same number of rows");
+            if (MATRIX_DEBUG) {
+                Log::log_message(Log::Log_Priority::DEBUG, "Matrix::broadcast_add_o",
+                    dimension_mismatch(target));
+            }
+            exit(EXIT_FAILURE);
+        }
+
+        // Each row gets a single value added, so walk the rows and add a scalar across each one
+        for (size_t i = 0; i < rows(); ++i) {
+            Matrix_Type* row = m_data + (i * cols());
+
+            if constexpr (std::is_same_v<Matrix_Type, float>) {
+                Matrix_Kernels_NS::kernels().add_scalar(row, target.m_data[i], row, cols());
+            }
+            else {
+                for (size_t j = 0; j < cols(); ++j) {
+                    row[j] += target.m_data[i];
+                }
+            }
+        }
+    }
+
      /**
      * Subtract two Matrix instances together
      * @param target Matrix to subtract with
@@ -773,8 +1075,8 @@ public:
      */
     Matrix<Matrix_Type>* scale(Matrix_Type value) const {
 
-        Matrix<Matrix_Type>* result = clone();
-        result->element_op(value, Element_Operations::MULTIPLY);
+        Matrix<Matrix_Type>* result = new Matrix<Matrix_Type>(rows(), cols());
+        element_op(value, *result, Element_Operations::MULTIPLY);
         return result;
     }
 
@@ -789,8 +1091,9 @@ public:
         if (!correct_sizes(destination, "Matrix::scale")) {
             exit(EXIT_FAILURE);
         }
-        copy_to(destination);
-        destination.element_op(value, Element_Operations::MULTIPLY);
+        destination.m_num_rows = rows();
+        destination.m_num_cols = cols();
+        element_op(value, destination, Element_Operations::MULTIPLY);
     }
 
     /**
@@ -810,8 +1113,8 @@ public:
      */
     Matrix<Matrix_Type>* add_scalar(Matrix_Type value) const {
 
-        Matrix<Matrix_Type>* result = clone();
-        result->element_op(value, Element_Operations::ADD);
+        Matrix<Matrix_Type>* result = new Matrix<Matrix_Type>(rows(), cols());
+        element_op(value, *result, Element_Operations::ADD);
         return result;
     }
 
@@ -826,8 +1129,9 @@ public:
         if (!correct_sizes(destination, "Matrix::add_scalar")) {
             exit(EXIT_FAILURE);
         }
-        copy_to(destination);
-        destination.element_op(value, Element_Operations::ADD);
+        destination.m_num_rows = rows();
+        destination.m_num_cols = cols();
+        element_op(value, destination, Element_Operations::ADD);
     }
 
     /**
@@ -847,8 +1151,20 @@ public:
      */
     Matrix<Matrix_Type>* apply(Matrix_Type (*func)(Matrix_Type)) const {
 
-        Matrix<Matrix_Type>* result = clone();
-        result->apply_fn(func);
+        Matrix<Matrix_Type>* result = new Matrix<Matrix_Type>(rows(), cols());
+        apply_fn(func, *result);
+        return result;
+    }
+
+    /**
+     * Apply a callable (lambda, functor, etc.) to a Matrix, storing the result in a new Matrix instance
+     * @param func Callable taking and returning Matrix_Type
+     * @returns Returns a new Matrix instance with the function applied
+     */
+    template <typename Function> Matrix<Matrix_Type>* apply(Function func) const {
+
+        Matrix<Matrix_Type>* result = new Matrix<Matrix_Type>(rows(), cols());
+        apply_fn(func, *result);
         return result;
     }
 
@@ -860,11 +1176,22 @@ public:
      */
     void apply(Matrix_Type (*func)(Matrix_Type), Matrix<Matrix_Type>& destination) const {
 
+        apply<Matrix_Type (*)(Matrix_Type)>(func, destination);
+    }
+
+    /**
+     * Apply a callable to a Matrix, storing the result in an existing Matrix
+     * @param func Callable taking and returning Matrix_Type
+     * @param destination The destination Matrix
+     */
+    template <typename Function> void apply(Function func, Matrix<Matrix_Type>& destination) const {
+
         if (!correct_sizes(destination, "Matrix::apply")) {
             exit(EXIT_FAILURE);
         }
-        copy_to(destination);
-        destination.apply_fn(func);
+        destination.m_num_rows = rows();
+        destination.m_num_cols = cols();
+        apply_fn(func, destination);
     }
 
     /**
@@ -877,6 +1204,15 @@ public:
         apply_fn(func);
     }
 
+    /**
+     * Apply a callable to a Matrix, overwriting the calling Matrix
+     * @param func Callable taking and returning Matrix_Type
+     */
+    template <typename Function> void apply_o(Function func) {
+
+        apply_fn(func);
+    }
+
     /**
      * Applies a function to a Matrix, taking in two parameters instead of one
      * @param func Function pointer that returns a value of type Matrix_Type
@@ -885,9 +1221,18 @@ public:
      */
     Matrix<Matrix_Type>* apply_second(Matrix_Type (*func)(Matrix_Type, Matrix_Type), Matrix_Type param) const {
 
-        Matrix<Matrix_Type>* result = clone();
-        result->apply_fn(func, param);
-        return result;
+        return apply_second<Matrix_Type (*)(Matrix_Type, Matrix_Type)>(func, param);
+    }
+
+    /**
+     * Applies a callable to a Matrix, taking in two parameters instead of one
+     * @param func Callable taking two Matrix_Type values and returning Matrix_Type
+     * @param param Additional parameter to be passed to func
+     * @returns Returns a new Matrix instance with the function applied
+     */
+    template <typename Function> Matrix<Matrix_Type>* apply_second(Function func, Matrix_Type param) const {
+
+        return apply([func, param](Matrix_Type value) { return func(value, param); });
     }
 
     /**
@@ -899,11 +1244,23 @@ public:
      */
     void apply_second(Matrix_Type (*func)(Matrix_Type, Matrix_Type), Matrix_Type param, Matrix<Matrix_Type>& destination) const {
 
+        apply_second<Matrix_Type (*)(Matrix_Type, Matrix_Type)>(func, param, destination);
+    }
+
+    /**
+     * Apply a callable to a Matrix, storing the result in an existing Matrix
+     * @param func Callable taking two Matrix_Type values and returning Matrix_Type
+     * @param param Additional parameter to be passed to func
+     * @param destination The destination Matrix
+     */
+    template <typename Function> void apply_second(Function func, Matrix_Type param, Matrix<Matrix_Type>& destination) const {
+
         if (!correct_sizes(destination, "Matrix::apply_second")) {
             exit(EXIT_FAILURE);
         }
-        copy_to(destination);
-        destination.apply_fn(func, param);
+        destination.m_num_rows = rows();
+        destination.m_num_cols = cols();
+        apply_fn([func, param](Matrix_Type value) { return func(value, param); }, destination);
     }
 
     /**
@@ -914,7 +1271,18 @@ public:
      */
     void apply_second_o(Matrix_Type (*func)(Matrix_Type, Matrix_Type), Matrix_Type param) {
 
-        apply_fn(func, param);
+        apply_second_o<Matrix_Type (*)(Matrix_Type, Matrix_Type)>(func, param);
+    }
+
+    /**
+     * Apply a callable to a Matrix, overwriting the calling Matrix. This variant
+     * takes two parameters to the function
+     * @param func Callable taking two Matrix_Type values and returning Matrix_Type
+     * @param param Additional parameter to be passed to func
+     */
+    template <typename Function> void apply_second_o(Function func, Matrix_Type param) {
+
+        apply_fn([func, param](Matrix_Type value) { return func(value, param); });
     }
 
     /**
@@ -924,14 +1292,17 @@ public:
      */
     void apply_row_o(Matrix_Type (*func)(Matrix_Type), size_t index) {
 
-        if (!exists(index, 0)) {
-            Log::log_message(Log::Log_Priority::ERROR, "Matrix::apply_row_o",
-                "Invalid index provided");
-            exit(EXIT_FAILURE);
-        }
-        for (size_t i = 0; i < cols(); ++i) {
-            set(index, i, func(get(index, i)));
-        }
+        apply_vector_fn(func, Vector_Orientation::ROW, index, "Matrix::apply_row_o");
+    }
+
+    /**
+     * Apply a callable to a row of a Matrix, overwriting the calling Matrix
+     * @param func Callable taking and returning Matrix_Type
+     * @param index Index of the row to apply the function to
+     */
+    template <typename Function> void apply_row_o(Function func, size_t index) {
+
+        apply_vector_fn(func, Vector_Orientation::ROW, index, "Matrix::apply_row_o");
     }
 
     /**
@@ -942,14 +1313,19 @@ public:
      */
     void apply_second_row_o(Matrix_Type (*func)(Matrix_Type, Matrix_Type), Matrix_Type param, size_t index) {
 
-        if (!exists(index, 0)) {
-            Log::log_message(Log::Log_Priority::ERROR, "Matrix::apply_second_row_o",
-                "Invalid index provided");
-            exit(EXIT_FAILURE);
-        }
-        for (size_t i = 0; i < cols(); ++i) {
-            set(index, i, func(get(index, i), param));
-        }
+        apply_second_row_o<Matrix_Type (*)(Matrix_Type, Matrix_Type)>(func, param, index);
+    }
+
+    /**
+     * Apply a callable to a row of a Matrix, overwriting the calling Matrix
+     * @param func Callable taking two Matrix_Type values and returning Matrix_Type
+     * @param param Additional parameter that func accepts
+     * @param index Index of the row to apply the function to
+     */
+    template <typename Function> void apply_second_row_o(Function func, Matrix_Type param, size_t index) {
+
+        apply_vector_fn([func, param](Matrix_Type value) { return func(value, param); },
+            Vector_Orientation::ROW, index, "Matrix::apply_second_row_o");
     }
 
     /**
@@ -959,14 +1335,17 @@ public:
      */
     void apply_column_o(Matrix_Type (*func)(Matrix_Type), size_t index) {
 
-        if (!exists(index, 0)) {
-            Log::log_message(Log::Log_Priority::ERROR, "Matrix::apply_column_o",
-                "Invalid index provided");
-            exit(EXIT_FAILURE);
-        }
-        for (size_t i = 0; i < rows(); ++i) {
-            set(i, index, func(get(i, index)));
-        }
+        apply_vector_fn(func, Vector_Orientation::COLUMN, index, "Matrix::apply_column_o");
+    }
+
+    /**
+     * Apply a callable to a column of a Matrix, overwriting the calling Matrix
+     * @param func Callable taking and returning Matrix_Type
+     * @param index Index of the column to apply the function to
+     */
+    template <typename Function> void apply_column_o(Function func, size_t index) {
+
+        apply_vector_fn(func, Vector_Orientation::COLUMN, index, "Matrix::apply_column_o");
     }
 
     /**
@@ -977,14 +1356,19 @@ public:
      */
     void apply_second_column_o(Matrix_Type (*func)(Matrix_Type, Matrix_Type), Matrix_Type param, size_t index) {
 
-        if (!exists(index, 0)) {
-            Log::log_message(Log::Log_Priority::ERROR, "Matrix::apply_second_column_o",
-                "Invalid index provided");
-            exit(EXIT_FAILURE);
-        }
-        for (size_t i = 0; i < rows(); ++i) {
-            set(i, index, func(get(i, index), param));
-        }
+        apply_second_column_o<Matrix_Type (*)(Matrix_Type, Matrix_Type)>(func, param, index);
+    }
+
+    /**
+     * Apply a callable to a column of a Matrix, overwriting the calling Matrix
+     * @param func Callable taking two Matrix_Type values and returning Matrix_Type
+     * @param param Additional parameter that func accepts
+     * @param index Index of the column to apply the function to
+     */
+    template <typename Function> void apply_second_column_o(Function func, Matrix_Type param, size_t index) {
+
+        apply_vector_fn([func, param](Matrix_Type value) { return func(value, param); },
+            Vector_Orientation::COLUMN, index, "Matrix::apply_second_column_o");
     }
 
     /**
@@ -1099,6 +1483,36 @@ public:
         }
     }
 
+    /**
+     * Copy a contiguous range of columns into a predefined destination, e.g. to split a batch
+     * @param start First column to copy
+     * @param count Number of columns to copy
+     * @param destination Destination Matrix of dimension [rows x count]
+     */
+    void get_columns(size_t start, size_t count, Matrix<Matrix_Type>& destination) const {
+
+        if (count == 0 || start + count > cols()) {
+            Log::log_message(Log::Log_Priority::ERROR, "Matrix::get_columns",
+                "Invalid column range provided to get_columns. Exiting");
+            if (MATRIX_DEBUG) {
+                Log::log_message(Log::Log_Priority::DEBUG, "Matrix::get_columns",
+                    std::format("Requested columns [{}, {}) but Matrix has {} columns", start, start + count, cols()));
+            }
+            exit(EXIT_FAILURE);
+        }
+
+        if (destination.rows() != rows() || destination.cols() != count) {
+            Log::log_message(Log::Log_Priority::ERROR, "Matrix::get_columns",
+                "Destination Matrix does not have the correct dimensions");
+            exit(EXIT_FAILURE);
+        }
+
+        // Each row of the range is contiguous, so copy it a row at a time
+        for (size_t i = 0; i < rows(); ++i) {
+            memcpy(destination.m_data + (i * count), m_data + (i * cols()) + start, count * sizeof(Matrix_Type));
+        }
+    }
+
     /**
      * Sum all the values in a Matrix
      * @returns Returns the sum of all values in the Matrix
@@ -0,0 +1,388 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Packed, cache-blocked GEMM used behind Matrix::dot. The loop structure follows
+ * the usual Goto / BLIS layout: the K dimension is split into KC slices, B is packed
+ * into NR-wide column panels that stay in L1, A is packed into MR-tall row panels
+ * that stay in L2, and a MR x NR register tile is accumulated by the micro-kernel.
+ *
+ * Operands are described by a row stride and a column stride, so a transposed operand
+ * is just a matter of swapping the strides. Only the packing routines ever touch the
+ * strided data.
+ *
+ * B may be stored as a narrower type (e.g. uint8_t pixels) with a scale factor. It is
+ * converted while it is packed, so the micro-kernel only ever sees Matrix_Type and the
+ * wide copy of B never exists outside the L1-sized panel.
+ *
+ * TODO: Continue adding functionality
+ */
+
+#ifndef MATRIX_GEMM_HPP
+#define MATRIX_GEMM_HPP
+
+/* Register tile computed by the micro-kernel (rows x columns of C) */
+#define MATRIX_GEMM_MR 4
+#define MATRIX_GEMM_NR 8
+
+/* Cache blocking. KC x NR panel of B sits in L1, MC x KC block of A sits in L2 */
+#define MATRIX_GEMM_KC 256
+#define MATRIX_GEMM_MC 128
+#define MATRIX_GEMM_NC 4096
+
+/* Alignment used for the packing buffers */
+#define MATRIX_GEMM_ALIGNMENT 64
+
+/* Standard dependencies */
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+/* Local dependencies */
+#include "Log.hpp"
+
+namespace Matrix_GEMM_NS {
+
+/**
+ * Growable, aligned scratch buffer used to hold the packed panels. One of these
+ * lives per thread, so repeated calls to gemm don't touch the allocator once the
+ * largest shape has been seen
+ */
+template <typename Matrix_Type> class Pack_Buffer {
+private:
+    Matrix_Type* m_data = NULL;
+    size_t m_capacity = 0;
+
+public:
+    ~Pack_Buffer() {
+        if (m_data != NULL) {
+            free(m_data);
+            m_data = NULL;
+        }
+    }
+
+    /**
+     * Get a buffer that holds at least the requested number of elements
+     * @param elements Number of elements required
+     * @returns Returns a pointer to aligned storage
+     */
+    Matrix_Type* reserve(size_t elements) {
+
+        if (elements <= m_capacity) { return m_data; }
+
+        if (m_data != NULL) { free(m_data); }
+
+        // aligned_alloc requires the size to be a multiple of the alignment
+        size_t bytes = elements * sizeof(Matrix_Type);
+        bytes = (bytes + MATRIX_GEMM_ALIGNMENT - 1) & ~((size_t)MATRIX_GEMM_ALIGNMENT - 1);
+
+        m_data = (Matrix_Type*)aligned_alloc(MATRIX_GEMM_ALIGNMENT, bytes);
+        if (m_data == NULL) {
+            Log::log_message(Log::Log_Priority::ERROR, "Matrix_GEMM::Pack_Buffer::reserve",
+                "Unable to allocate memory for GEMM packing buffer. Exiting");
+            exit(EXIT_FAILURE);
+        }
+        m_capacity = elements;
+        return m_data;
+    }
+};
+
+/**
+ * Pack an mc x kc block of A into MR-tall row panels. Each panel is stored
+ * column by column so the micro-kernel reads it sequentially. Rows past mc
+ * are zero padded
+ * @param mc Rows in the block
+ * @param kc Columns in the block
+ * @param a Pointer to the top left element of the block
+ * @param rsa Row stride of A
+ * @param csa Column stride of A
+ * @param packed Destination buffer
+ */
+template <typename Matrix_Type>
+inline void pack_a(size_t mc, size_t kc, const Matrix_Type* a, size_t rsa, size_t csa, Matrix_Type* packed) {
+
+    for (size_t i = 0; i < mc; i += MATRIX_GEMM_MR) {
+
+        size_t mr = (mc - i < MATRIX_GEMM_MR) ? mc - i : MATRIX_GEMM_MR;
+        const Matrix_Type* panel = a + (i * rsa);
+
+        for (size_t p = 0; p < kc; ++p) {
+            size_t r = 0;
+            for (; r < mr; ++r) {
+                packed[r] = panel[(r * rsa) + (p * csa)];
+            }
+            for (; r < MATRIX_GEMM_MR; ++r) {
+                packed[r] = 0;
+            }
+            packed += MATRIX_GEMM_MR;
+        }
+    }
+}
+
+/**
+ * Pack a kc x nc block of B into NR-wide column panels. Each panel is stored
+ * row by row so the micro-kernel reads it sequentially. Columns past nc
+ * are zero padded. A B stored as another type is converted and multiplied by scale_b
+ * @param kc Rows in the block
+ * @param nc Columns in the block
+ * @param b Pointer to the top left element of the block
+ * @param rsb Row stride of B
+ * @param csb Column stride of B
+ * @param scale_b Factor applied to every element of a converted B
+ * @param packed Destination buffer
+ */
+template <typename Matrix_Type, typename B_Type>
+inline void pack_b(size_t kc, size_t nc, const B_Type* b, size_t rsb, size_t csb, Matrix_Type scale_b,
+    Matrix_Type* packed) {
+
+    for (size_t j = 0; j < nc; j += MATRIX_GEMM_NR) {
+
+        size_t nr = (nc - j < MATRIX_GEMM_NR) ? nc - j : MATRIX_GEMM_NR;
+        const B_Type* panel = b + (j * csb);
+
+        for (size_t p = 0; p < kc; ++p) {
+            const B_Type* row = panel + (p * rsb);
+            size_t c = 0;
+
+            if constexpr (std::is_same_v<Matrix_Type, B_Type>) {
+                // Contiguous rows are the common case (B not transposed), let it become a memcpy
+                if (csb == 1) {
+                    for (; c < nr; ++c) { packed[c] = row[c]; }
+                }
+                else {
+                    for (; c < nr; ++c) { packed[c] = row[c * csb]; }
+                }
+            }
+            else {
+                if (csb == 1) {
+                    for (; c < nr; ++c) { packed[c] = (Matrix_Type)row[c] * scale_b; }
+                }
+                else {
+                    for (; c < nr; ++c) { packed[c] = (Matrix_Type)row[c * csb] * scale_b; }
+                }
+            }
+            for (; c < MATRIX_GEMM_NR; ++c) {
+                packed[c] = 0;
+            }
+            packed += MATRIX_GEMM_NR;
+        }
+    }
+}
+
+/**
+ * Compute a MR x NR tile of C from one packed panel of A and one packed panel of B.
+ * The accumulators are a fixed size array so the compiler keeps them in vector registers
+ * @param kc Depth of the panels
+ * @param a Packed A panel (kc x MR)
+ * @param b Packed B panel (kc x NR)
+ * @param c Pointer to the top left element of the C tile
+ * @param ldc Leading dimension (row stride) of C
+ * @param mr Number of valid rows in the tile
+ * @param nr Number of valid columns in the tile
+ * @param accumulate True to add to the existing contents of C, false to overwrite
+ */
+template <typename Matrix_Type>
+inline void micro_kernel(size_t kc, const Matrix_Type* __restrict__ a, const Matrix_Type* __restrict__ b,
+    Matrix_Type* __restrict__ c, size_t ldc, size_t mr, size_t nr, bool accumulate) {
+
+    Matrix_Type acc[MATRIX_GEMM_MR][MATRIX_GEMM_NR];
+
+    for (size_t i = 0; i < MATRIX_GEMM_MR; ++i) {
+        for (size_t j = 0; j < MATRIX_GEMM_NR; ++j) {
+            acc[i][j] = 0;
+        }
+    }
+
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t i = 0; i < MATRIX_GEMM_MR; ++i) {
+            const Matrix_Type a_value = a[i];
+            for (size_t j = 0; j < MATRIX_GEMM_NR; ++j) {
+                acc[i][j] += a_value * b[j];
+            }
+        }
+        a += MATRIX_GEMM_MR;
+        b += MATRIX_GEMM_NR;
+    }
+
+    // Full tiles take the fast path, edge tiles only write the valid region
+    if (mr == MATRIX_GEMM_MR && nr == MATRIX_GEMM_NR) {
+        for (size_t i = 0; i < MATRIX_GEMM_MR; ++i) {
+            Matrix_Type* c_row = c + (i * ldc);
+            if (accumulate) {
+                for (size_t j = 0; j < MATRIX_GEMM_NR; ++j) { c_row[j] += acc[i][j]; }
+            }
+            else {
+                for (size_t j = 0; j < MATRIX_GEMM_NR; ++j) { c_row[j] = acc[i][j]; }
+            }
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < mr; ++i) {
+        Matrix_Type* c_row = c + (i * ldc);
+        for (size_t j = 0; j < nr; ++j) {
+            c_row[j] = accumulate ? c_row[j] + acc[i][j] : acc[i][j];
+        }
+    }
+}
+
+/**
+ * Matrix-vector product used when C has a single column. Packing A would cost more
+ * than the product itself here, so rows of A are streamed directly
+ * @param m Rows of A
+ * @param k Columns of A
+ * @param a Pointer to A
+ * @param rsa Row stride of A
+ * @param csa Column stride of A
+ * @param x Pointer to the vector
+ * @param incx Stride between vector elements
+ * @param y Destination vector
+ * @param incy Stride between destination elements
+ * @param accumulate True to add to the existing contents of y
+ */
+template <typename Matrix_Type>
+inline void gemv(size_t m, size_t k, const Matrix_Type* a, size_t rsa, size_t csa,
+    const Matrix_Type* x, size_t incx, Matrix_Type* y, size_t incy, bool accumulate) {
+
+    // A is stored column-wise here (transposed operand), so sweep y once per column of A
+    if (csa != 1) {
+        for (size_t i = 0; i < m; ++i) {
+            if (!accumulate) { y[i * incy] = 0; }
+        }
+        for (size_t p = 0; p < k; ++p) {
+            const Matrix_Type x_value = x[p * incx];
+            const Matrix_Type* a_col = a + (p * csa);
+            for (size_t i = 0; i < m; ++i) {
+                y[i * incy] += a_col[i * rsa] * x_value;
+            }
+        }
+        return;
+    }
+
+    // Rows of A are contiguous. Use independent partial sums so the loop vectorizes
+    // without needing to reassociate a single floating point reduction
+    const size_t lanes = 8;
+
+    for (size_t i = 0; i < m; ++i) {
+        const Matrix_Type* a_row = a + (i * rsa);
+        Matrix_Type partial[lanes] = {0, 0, 0, 0, 0, 0, 0, 0};
+        size_t p = 0;
+
+        if (incx == 1) {
+            for (; p + lanes <= k; p += lanes) {
+                for (size_t l = 0; l < lanes; ++l) {
+                    partial[l] += a_row[p + l] * x[p + l];
+                }
+            }
+        }
+
+        Matrix_Type sum = 0;
+        for (size_t l = 0; l < lanes; ++l) { sum += partial[l]; }
+        for (; p < k; ++p) { sum += a_row[p] * x[p * incx]; }
+
+        y[i * incy] = accumulate ? y[i * incy] + sum : sum;
+    }
+}
+
+/**
+ * General matrix multiplication C = A * B (or C += A * B). All three operands are
+ * addressed through strides, allowing transposed views of A and B without copies
+ * @param m Rows of C and of op(A)
+ * @param n Columns of C and of op(B)
+ * @param k Columns of op(A) and rows of op(B)
+ * @param a Pointer to A
+ * @param rsa Row stride of op(A)
+ * @param csa Column stride of op(A)
+ * @param b Pointer to B
+ * @param rsb Row stride of op(B)
+ * @param csb Column stride of op(B)
+ * @param c Pointer to C. C is always row-major
+ * @param ldc Leading dimension (row stride) of C
+ * @param accumulate True to add the product to C, false to overwrite C
+ * @param scale_b Factor applied to B when it is stored as another type than Matrix_Type
+ */
+template <typename Matrix_Type, typename B_Type = Matrix_Type>
+void gemm(size_t m, size_t n, size_t k, const Matrix_Type* a, size_t rsa, size_t csa,
+    const B_Type* b, size_t rsb, size_t csb, Matrix_Type* c, size_t ldc, bool accumulate,
+    Matrix_Type scale_b = 1) {
+
+    if (m == 0 || n == 0) { return; }
+
+    if (k == 0) {
+        if (!accumulate) {
+            for (size_t i = 0; i < m; ++i) { memset(c + (i * ldc), 0, n * sizeof(Matrix_Type)); }
+        }
+        return;
+    }
+
+    static thread_local Pack_Buffer<Matrix_Type> a_buffer;
+    static thread_local Pack_Buffer<Matrix_Type> b_buffer;
+
+    // Single column outputs are matrix-vector products. A narrow vector is converted once up
+    // front rather than once for every row of A
+    if (n == 1) {
+        if constexpr (std::is_same_v<Matrix_Type, B_Type>) {
+            gemv(m, k, a, rsa, csa, b, rsb, c, ldc, accumulate);
+        }
+        else {
+            Matrix_Type* x = b_buffer.reserve(k);
+            for (size_t p = 0; p < k; ++p) { x[p] = (Matrix_Type)b[p * rsb] * scale_b; }
+            gemv(m, k, a, rsa, csa, (const Matrix_Type*)x, 1, c, ldc, accumulate);
+        }
+        return;
+    }
+
+    const size_t nc_max = (n < MATRIX_GEMM_NC) ? n : MATRIX_GEMM_NC;
+    const size_t mc_max = (m < MATRIX_GEMM_MC) ? m : MATRIX_GEMM_MC;
+    const size_t kc_max = (k < MATRIX_GEMM_KC) ? k : MATRIX_GEMM_KC;
+
+    // Round up to whole panels since packing zero pads the edges
+    Matrix_Type* packed_a = a_buffer.reserve(
+        ((mc_max + MATRIX_GEMM_MR - 1) / MATRIX_GEMM_MR) * MATRIX_GEMM_MR * kc_max);
+    Matrix_Type* packed_b = b_buffer.reserve(
+        ((nc_max + MATRIX_GEMM_NR - 1) / MATRIX_GEMM_NR) * MATRIX_GEMM_NR * kc_max);
+
+    for (size_t jc = 0; jc < n; jc += MATRIX_GEMM_NC) {
+        size_t nc = (n - jc < MATRIX_GEMM_NC) ? n - jc : MATRIX_GEMM_NC;
+
+        for (size_t pc = 0; pc < k; pc += MATRIX_GEMM_KC) {
+            size_t kc = (k - pc < MATRIX_GEMM_KC) ? k - pc : MATRIX_GEMM_KC;
+            // Only the first K slice may overwrite C, the rest add onto it
+            bool slice_accumulate = accumulate || pc != 0;
+
+            pack_b(kc, nc, b + (pc * rsb) + (jc * csb), rsb, csb, scale_b, packed_b);
+
+            for (size_t ic = 0; ic < m; ic += MATRIX_GEMM_MC) {
+                size_t mc = (m - ic < MATRIX_GEMM_MC) ? m - ic : MATRIX_GEMM_MC;
+
+                pack_a(mc, kc, a + (ic * rsa) + (pc * csa), rsa, csa, packed_a);
+
+                for (size_t jr = 0; jr < nc; jr += MATRIX_GEMM_NR) {
+                    size_t nr = (nc - jr < MATRIX_GEMM_NR) ? nc - jr : MATRIX_GEMM_NR;
+                    const Matrix_Type* b_panel = packed_b + (jr * kc);
+
+                    for (size_t ir = 0; ir < mc; ir += MATRIX_GEMM_MR) {
+                        size_t mr = (mc - ir < MATRIX_GEMM_MR) ? mc - ir : MATRIX_GEMM_MR;
+
+                        micro_kernel(kc, packed_a + (ir * kc), b_panel,
+                            c + ((ic + ir) * ldc) + jc + jr, ldc, mr, nr, slice_accumulate);
+                    }
+                }
+            }
+        }
+    }
+}
+
+};
+
+#endif
@@ -0,0 +1,97 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Element-wise float kernels used by Matrix. Each kernel is implemented once per
+ * instruction set (scalar, SSE, AVX2, AVX-512) and the widest one the running CPU
+ * supports is selected at startup from CPUID, so a single binary runs everywhere.
+ *
+ * All kernels tolerate destination aliasing either source, which is how the
+ * in-place (_o) Matrix operations are expressed.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef MATRIX_KERNELS_HPP
+#define MATRIX_KERNELS_HPP
+
+/* Standard dependencies */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Local dependencies */
+
+namespace Matrix_Kernels_NS {
+
+typedef enum {
+    SCALAR = 0,
+    SSE = 1,
+    AVX2 = 2,
+    AVX512 = 3
+} Instruction_Set;
+
+/**
+ * Table of element-wise kernels for a given instruction set
+ */
+typedef struct {
+    /* destination[i] = a[i] + b[i] */
+    void (*add)(const float* a, const float* b, float* destination, size_t elements);
+    /* destination[i] = a[i] - b[i] */
+    void (*subtract)(const float* a, const float* b, float* destination, size_t elements);
+    /* destination[i] = a[i] * b[i] */
+    void (*multiply)(const float* a, const float* b, float* destination, size_t elements);
+    /* destination[i] = a[i] * value */
+    void (*scale)(const float* a, float value, float* destination, size_t elements);
+    /* destination[i] = a[i] + value */
+    void (*add_scalar)(const float* a, float value, float* destination, size_t elements);
+    /* destination[i] = value */
+    void (*fill)(float* destination, float value, size_t elements);
+    /* destination[i] = (float)a[i] / divisor, e.g. to normalize raw pixels */
+    void (*convert_u8)(const uint8_t* a, float divisor, float* destination, size_t elements);
+    /* destination[i] = dot(a[i * cols .. (i + 1) * cols), x) + bias[i] for i in [0, rows), with a
+     * row-major. bias may be NULL. destination must not alias a or x */
+    void (*gemv)(const float* a, size_t rows, size_t cols, const float* x, const float* bias, float* destination);
+    /* The instruction set the kernels were built for */
+    Instruction_Set instruction_set;
+} Kernel_Table;
+
+/**
+ * Get the kernel table selected for this CPU
+ * @returns Returns a const reference to the active Kernel_Table
+ */
+const Kernel_Table& kernels(void);
+
+/**
+ * Query CPUID for the widest instruction set supported by this CPU (and enabled by the OS)
+ * @returns Returns the best available Instruction_Set
+ */
+Instruction_Set detect_instruction_set(void);
+
+/**
+ * Override the active kernels, e.g. to compare instruction sets on the same machine.
+ * Requests wider than what the CPU supports are clamped to the detected instruction set
+ * @param instruction_set The Instruction_Set to use
+ * @returns Returns the Instruction_Set that is now active
+ */
+Instruction_Set select_instruction_set(Instruction_Set instruction_set);
+
+/**
+ * Get a printable name for an instruction set
+ * @param instruction_set The Instruction_Set to name
+ * @returns Returns a C string with the name
+ */
+const char* instruction_set_name(Instruction_Set instruction_set);
+
+};
+
+#endif
@@ -0,0 +1,186 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Layout and helpers for the v2 model file. Unlike v1 every field is fixed width and
+ * little-endian, and every tensor starts on a MODEL_FILE_ALIGNMENT boundary, so an fp32
+ * model can be mapped and used in place.
+ *
+ * File structure for model v2
+ *
+ * Model_File_Header (64 bytes)
+ * uint32_t[number_of_layers] number_of_neurons, zero padded to a multiple of 8 bytes
+ * Model_File_Tensor[num_tensors] table of contents, a weights and a biases entry per layer after the input
+ * Tensor data, each tensor aligned to MODEL_FILE_ALIGNMENT and zero padded in between
+ *
+ * header_crc covers the header up to itself, toc_crc covers the layer sizes and the table of
+ * contents, and each table entry holds the CRC32C of its own tensor's bytes.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef MODEL_FILE_HPP
+#define MODEL_FILE_HPP
+
+/* "NNV2" when read as bytes */
+#define MODEL_FILE_MAGIC 0x32564E4E
+#define MODEL_FILE_VERSION 2
+/* Alignment of every tensor in the file */
+#define MODEL_FILE_ALIGNMENT 64
+/* Check every tensor's CRC32C when opening a model, not just the header and table of contents */
+#define MODEL_FILE_VERIFY_TENSORS 1
+/* INT8 tensors are stored as round(value / scale) with scale = max(|value|) / MODEL_FILE_INT8_MAX */
+#define MODEL_FILE_INT8_MAX 127
+
+/* Standard dependencies */
+#include <bit>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Local dependencies */
+#include "Log.hpp"
+
+namespace Model_File_NS {
+
+typedef enum {
+    /* 32-bit floats, the only dtype that is mapped rather than decoded */
+    FP32 = 0,
+    /* IEEE 754 half precision */
+    FP16 = 1,
+    /* Symmetric 8-bit integers with one scale per tensor */
+    INT8 = 2
+} Tensor_Dtype;
+
+typedef enum {
+    TENSOR_WEIGHTS = 0,
+    TENSOR_BIASES = 1
+} Tensor_Kind;
+
+struct Model_File_Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_layers;
+    uint32_t num_tensors;
+    float learning_rate;
+    float lambda;
+    /* 0 = Quadratic, 1 = Cross Entropy */
+    uint32_t cost_function;
+    uint32_t flags;
+    /* Offset of the table of contents */
+    uint64_t toc_offset;
+    uint64_t file_size;
+    uint32_t toc_crc;
+    uint32_t reserved[2];
+    uint32_t header_crc;
+};
+
+struct Model_File_Tensor {
+    uint32_t layer;
+    /* Tensor_Kind */
+    uint32_t kind;
+    /* Tensor_Dtype */
+    uint32_t dtype;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t crc;
+    /* Only used by INT8 */
+    float scale;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+};
+
+static_assert(sizeof(Model_File_Header) == 64, "Model_File_Header must be 64 bytes");
+static_assert(sizeof(Model_File_Tensor) == 48, "Model_File_Tensor must be 48 bytes");
+
+/**
+ * Check whether this host can read and write v2 files. The fields are stored as they sit in
+ * memory, which is only the defined little-endian layout on little-endian hosts
+ * @returns Returns true on little-endian hosts
+ */
+constexpr bool host_supported(void) {
+    return std::endian::native == std::endian::little;
+}
+
+/**
+ * Round an offset up to the next MODEL_FILE_ALIGNMENT boundary
+ * @param offset The offset to align
+ * @returns Returns the aligned offset
+ */
+constexpr size_t align(size_t offset) {
+    return ((offset + MODEL_FILE_ALIGNMENT - 1) / MODEL_FILE_ALIGNMENT) * MODEL_FILE_ALIGNMENT;
+}
+
+/**
+ * Compute the CRC32C (Castagnoli) of a block of memory, using the SSE4.2 instruction when the
+ * CPU has it
+ * @param data Pointer to the bytes
+ * @param bytes Number of bytes
+ * @param crc CRC of any preceding bytes, to continue from
+ * @returns Returns the CRC32C
+ */
+uint32_t crc32c(const void* data, size_t bytes, uint32_t crc = 0);
+
+/**
+ * Get the number of bytes one element of a dtype takes
+ * @param dtype The Tensor_Dtype
+ * @returns Returns the element size in bytes, or 0 for an unknown dtype
+ */
+size_t dtype_size(uint32_t dtype);
+
+/**
+ * Get a readable name for a dtype
+ * @param dtype The Tensor_Dtype
+ * @returns Returns a static string
+ */
+const char* dtype_name(uint32_t dtype);
+
+/**
+ * Convert floats to a dtype for storage
+ * @param source The floats to convert
+ * @param elements Number of floats
+ * @param dtype The Tensor_Dtype to store as
+ * @param destination Buffer of elements * dtype_size(dtype) bytes
+ * @returns Returns the scale to store with the tensor, 1 unless dtype is INT8
+ */
+float encode_tensor(const float* source, size_t elements, Tensor_Dtype dtype, void* destination);
+
+/**
+ * Convert a stored tensor back to floats
+ * @param source The stored tensor
+ * @param elements Number of elements
+ * @param dtype The Tensor_Dtype it was stored as
+ * @param scale The scale stored with the tensor
+ * @param destination Buffer of elements floats
+ */
+void decode_tensor(const void* source, size_t elements, Tensor_Dtype dtype, float scale, float* destination);
+
+/**
+ * Convert a float to IEEE 754 half precision, rounding to nearest even
+ * @param value The float to convert
+ * @returns Returns the half precision bits
+ */
+uint16_t float_to_half(float value);
+
+/**
+ * Convert IEEE 754 half precision to a float
+ * @param value The half precision bits
+ * @returns Returns the float
+ */
+float half_to_float(uint16_t value);
+
+};
+
+#endif
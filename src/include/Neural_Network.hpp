@@ -8,7 +8,7 @@
  *                                                                                                               
  * Project: Basic Neural Network in C++
  * @author : Samuel Andersen
- * @version: 2025-07-22
+ * @version: 2026-10-17
  *
  * General Notes:
  *
@@ -21,6 +21,12 @@
 #define NEURAL_NETWORK_DEBUG 1
 #define NEURAL_NETWORK_SHOW_STEP_LOSS 1
 #define NEURAL_NETWORK_SHOW_LOSS_NUM_STEPS 100
+/* Number of outputs the cross entropy cost takes the log of at once, on the stack */
+#define NEURAL_NETWORK_COST_CHUNK_SIZE 256
+/* Scale applied to uint8_t inputs by default, mapping raw pixels onto [0, 1] */
+#define NEURAL_NETWORK_BYTE_INPUT_SCALE (1.0f / 255.0f)
+/* Hogwild! steps a workspace takes between applying the accumulated weight decay */
+#define NEURAL_NETWORK_HOGWILD_DECAY_INTERVAL 64
 
 /* Markers to help with loading / saving Neural Networks */
 #define NN_HEADER_MAGIC 0x0000AA00
@@ -32,7 +38,8 @@
 #define NN_BIAS_END 0x00000F02
 
 /**
- * File structure for model
+ * File structure for model v1, still read by the loading constructor and written by save_v1().
+ * save() writes v2, described in Model_File.hpp
  * 
  * uint32_t NN_HEADER_MAGIC
  * float learning_rate (generally 0.1)
@@ -53,19 +60,41 @@
  */
 
 /* Standard dependencies */
+#include <memory>
 #include <vector>
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <type_traits>
 
 /* Local dependencies */
+#include "Allocation_Counter.hpp"
+#include "Fast_Math.hpp"
+#include "Inference_Context.hpp"
 #include "Log.hpp"
 #include "Matrix.hpp"
+#include "Model_File.hpp"
 #include "Neural_Network_Layer.hpp"
+#include "Neural_Network_Workspace.hpp"
+#include "Thread_Pool.hpp"
 
 /* Using */
 using Matrix = Matrix_NS::Matrix<float>;
+using Byte_Matrix = Matrix_NS::Matrix<uint8_t>;
 using Neural_Network_Layer = Neural_Network_Layer_NS::Neural_Network_Layer;
 using Layer_Type = Neural_Network_Layer_NS::Layer_Type;
+using Neural_Network_Workspace = Neural_Network_Workspace_NS::Neural_Network_Workspace;
+using Workspace_Type = Neural_Network_Workspace_NS::Workspace_Type;
+using Inference_Context = Inference_Context_NS::Inference_Context;
+using Thread_Pool = Thread_Pool_NS::Thread_Pool;
+using Model_File_Header = Model_File_NS::Model_File_Header;
+using Model_File_Tensor = Model_File_NS::Model_File_Tensor;
 
 namespace Neural_Network_NS {
 
@@ -86,12 +115,11 @@ public:
 
     /**
      * Calculate the delta between the output layer and the label
-     * @param z The z layer Matrix, before the activation function is applied
      * @param output The activations from the output layer
      * @param label The correct / expected value
      * @param destination Reference to a Matrix that stores the delta
      */
-    static void delta(const Matrix& z, const Matrix& output, const Matrix& label, Matrix& destination);
+    static void delta(const Matrix& output, const Matrix& label, Matrix& destination);
 };
 
 class Cross_Entropy_Cost {
@@ -106,12 +134,11 @@ public:
 
     /**
      * Calculate the delta between the output layer and the label
-     * @param z The z layer Matrix, before the activation function is applied
      * @param output The activations from the output layer
      * @param label The correct / expected value
      * @param destination Reference to a Matrix that stores the delta
      */
-    static void delta(const Matrix& z, const Matrix& output, const Matrix& label, Matrix& destination);
+    static void delta(const Matrix& output, const Matrix& label, Matrix& destination);
 };
 
 class Neural_Network {
@@ -121,19 +148,175 @@ private:
     Neural_Network_Layer** m_layers = NULL;
     float m_learning_rate = 0;
     float m_lambda = 0;
+    /* Scratch space for training, created on the first training step */
+    Neural_Network_Workspace* m_workspace = NULL;
+    /* Threads and per-worker scratch space for parallel training, created on first use */
+    Thread_Pool* m_thread_pool = NULL;
+    Neural_Network_Workspace** m_worker_workspaces = NULL;
+    float* m_worker_losses = NULL;
+    size_t m_num_workers = 0;
+    /* Inference-only networks hold just weights and biases, and refuse to train */
+    bool m_inference_only = false;
+    /* Model file mapped by load_v2(), which fp32 layers view in place */
+    void* m_mapping = NULL;
+    size_t m_mapping_size = 0;
     
     /* Cost function details*/
     Cost_Function m_cost_type = Cost_Function::QUADRATIC;
     float (*cost)(const Matrix& output, const Matrix& expected) = Quadratic_Cost::cost;
-    void (*delta)(const Matrix& z, const Matrix& output, const Matrix& label, Matrix& destination) = Quadratic_Cost::delta;
+    void (*delta)(const Matrix& output, const Matrix& label, Matrix& destination) = Quadratic_Cost::delta;
 
     /* Private functions */
     
     /**
-     * Run inference and don't produce a result, storing in the output layer instead
-     * @param input Reference to a Matrix to use as the input
+     * Run inference and don't produce a result, storing z and the activations of each
+     * layer in a workspace instead
+     * @param input Reference to a Matrix to use as the input, either float or uint8_t
+     * @param workspace The workspace to write to, shaped for input.cols()
+     * @param input_scale Factor applied to uint8_t inputs inside the first layer's GEMM
      */
-    void training_inference(const Matrix& input);
+    template <typename Input_Type>
+    void training_inference(const Matrix_NS::Matrix<Input_Type>& input, Neural_Network_Workspace& workspace,
+        float input_scale = 1) const;
+
+    /**
+     * Run forward and backward passes for a batch, leaving the summed (unscaled) weight and
+     * bias gradients in the workspace's NABLA_W and NABLA_B. Doesn't modify the network
+     * @param inputs A Matrix containing one input per column, either float or uint8_t
+     * @param labels A Matrix containing one label per column
+     * @param workspace The workspace to use, shaped for inputs.cols()
+     * @param input_scale Factor applied to uint8_t inputs inside the first layer's GEMMs
+     * @param input_gradient False to leave the first layer's NABLA_W uncomputed, for callers
+     * that build that update themselves from the first layer's ERRORS
+     * @returns Returns the total loss across the batch
+     */
+    template <typename Input_Type>
+    float compute_gradients(const Matrix_NS::Matrix<Input_Type>& inputs, const Matrix& labels,
+        Neural_Network_Workspace& workspace, float input_scale = 1, bool input_gradient = true) const;
+
+    /**
+     * Shared body of the batch_train overloads
+     * @param inputs A Matrix containing one input per column, either float or uint8_t
+     * @param labels A Matrix containing one label per column
+     * @param dataset_size The size of the full dataset
+     * @param input_scale Factor applied to uint8_t inputs
+     * @returns Returns the average loss across the batch
+     */
+    template <typename Input_Type>
+    float batch_step(const Matrix_NS::Matrix<Input_Type>& inputs, const Matrix& labels, size_t dataset_size,
+        float input_scale);
+
+    /**
+     * Shared body of the inference overloads. Only writes to the context and destination, so
+     * any number of threads can run it at once with their own contexts
+     * @param input A Matrix containing one input per column, either float or uint8_t
+     * @param destination Matrix to write the results to
+     * @param input_scale Factor applied to uint8_t inputs
+     * @param context Scratch space for the activations, built for this network's topology
+     */
+    template <typename Input_Type>
+    void feed_forward(const Matrix_NS::Matrix<Input_Type>& input, Matrix& destination, float input_scale,
+        Inference_Context& context) const;
+
+    /**
+     * Single-sample path of feed_forward. Each layer is one GEMV with the bias fused in, so
+     * nothing goes through the general dot product. Called after feed_forward's checks
+     * @param input A Matrix with a single column, either float or uint8_t
+     * @param destination Matrix to write the result to
+     * @param input_scale Factor applied to uint8_t inputs
+     * @param context Scratch space for the activations and the converted input
+     */
+    template <typename Input_Type>
+    void feed_forward_single(const Matrix_NS::Matrix<Input_Type>& input, Matrix& destination, float input_scale,
+        Inference_Context& context) const;
+
+    /**
+     * Get the calling thread's own inference context, creating or growing it when needed
+     * @param batch_size The number of columns in the next inference call
+     * @returns Returns a reference to a context shaped for this network and batch size
+     */
+    Inference_Context& thread_context(size_t batch_size) const;
+
+    /**
+     * Check whether an inference context was built for this network's topology
+     * @param context The context to check
+     * @returns Returns true if every layer size matches
+     */
+    bool context_matches(const Inference_Context& context) const;
+
+    /**
+     * Update the weights and biases from the gradients in a workspace
+     * @param workspace The workspace holding NABLA_W and NABLA_B, summed over the batch
+     * @param batch_size The number of examples the gradients were summed over
+     * @param dataset_size The size of the full dataset
+     */
+    void apply_gradients(Neural_Network_Workspace& workspace, size_t batch_size, size_t dataset_size);
+
+    /**
+     * Update the weights and biases for a Hogwild! step, writing each weight at most once. The
+     * first layer only updates the weight columns of nonzero inputs, straight from its ERRORS.
+     * Weight decay is applied every NEURAL_NETWORK_HOGWILD_DECAY_INTERVAL steps of the workspace
+     * rather than every step
+     * @param input The input Matrix the gradients were computed from
+     * @param workspace The workspace from compute_gradients, with input_gradient false
+     * @param batch_size The number of examples the gradients were summed over
+     * @param dataset_size The size of the full dataset
+     */
+    void apply_hogwild_gradients(const Matrix& input, Neural_Network_Workspace& workspace, size_t batch_size,
+        size_t dataset_size);
+
+    /**
+     * Create the workspace if needed and shape it for a batch size
+     * @param batch_size The number of examples in the next training step
+     * @returns Returns true if the workspace had to allocate memory
+     */
+    bool prepare_workspace(size_t batch_size);
+
+    /**
+     * Create the thread pool and per-worker workspaces if needed, and shape each workspace
+     * for its share of the batch
+     * @param num_workers The number of workers to split the batch across
+     * @param batch_size The number of examples in the next training step
+     * @returns Returns true if anything had to allocate memory
+     */
+    bool prepare_workers(size_t num_workers, size_t batch_size);
+
+    /**
+     * Free the thread pool and per-worker workspaces
+     */
+    void release_workers(void);
+
+    /**
+     * Exit if the network can't be trained, because it has no layers or is inference-only
+     * @param caller Name of the calling function, for the log message
+     */
+    void require_trainable(const char* caller) const;
+
+    /**
+     * Allocate the layers of the network
+     * @param layer_info Vector of size_t containing the sizes of each layer and number of layers
+     * @param import Whether to create zeroed weights and biases to load into, rather than random ones
+     */
+    void allocate_layers(const std::vector<size_t>& layer_info, bool import);
+
+    /**
+     * Set the cost type along with the matching cost and delta functions
+     * @param cost_type Type of cost function to use
+     */
+    void set_cost_function(Cost_Function cost_type);
+
+    /**
+     * Load a v1 model, reading each block straight into the layers. Exits if the file is invalid
+     * @param path Path to the Neural_Network file
+     */
+    void load_v1(const char* path);
+
+    /**
+     * Load a v2 model by mapping it. fp32 tensors are used in place, fp16 and int8 ones are
+     * decoded. Exits if any header, table of contents or tensor check fails
+     * @param path Path to the Neural_Network file
+     */
+    void load_v2(const char* path);
 public:
     /* Public functions */
 
@@ -152,9 +335,13 @@ public:
     Neural_Network();
 
     /**
-     * Constructor for loading a Neural_Network from a file
+     * Constructor for loading a Neural_Network from a v1 or v2 model file. Exits if the file
+     * can't be read or doesn't match the layout of its version
      * @param path Path to the Neural_Network file
+     * @param inference_only True to load just the weights and biases for serving, false to keep
+     * training the loaded model
      */
+    Neural_Network(const char* path, bool inference_only = true);
 
     /**
      * Destructor for Neural_Network
@@ -183,6 +370,54 @@ public:
      */
     float batch_train(const Matrix& inputs, const Matrix& labels, size_t dataset_size);
 
+    /**
+     * Execute training on the Neural Network with raw uint8_t inputs, e.g. pixels straight from
+     * the dataset. The inputs are converted and scaled inside the first layer's GEMMs, so a float
+     * copy of them is never made
+     * @param inputs A Byte_Matrix containing one input per column, [input_neurons x batch_size]
+     * @param labels A Matrix instance containing one label per column, [num_labels x batch_size]
+     * @param dataset_size The size of the full dataset
+     * @param input_scale Factor every input is multiplied by, 1 / 255 for pixels
+     * @returns Returns the total loss across the number of steps in the batch
+     */
+    float batch_train(const Byte_Matrix& inputs, const Matrix& labels, size_t dataset_size,
+        float input_scale = NEURAL_NETWORK_BYTE_INPUT_SCALE);
+
+    /**
+     * Execute batch training on the Neural Network, splitting the columns of the batch across
+     * a pool of threads. Each thread computes the gradient for its share, the gradients are
+     * summed with a tree reduction and then applied once, so the result matches batch_train
+     * up to float rounding
+     * @param inputs A Matrix instance containing one input per column. The size of the Matrix
+     * should be [input_neurons x batch_size]
+     * @param labels A Matrix instance containing one label per column. The size of the Matrix
+     * should be [num_labels x batch_size]
+     * @param dataset_size The size of the full dataset
+     * @param num_threads Number of threads to use, including the caller
+     * @returns Returns the total loss across the number of steps in the batch
+     */
+    float parallel_batch_train(const Matrix& inputs, const Matrix& labels, size_t dataset_size, size_t num_threads);
+
+    /**
+     * Execute a Hogwild! training step: compute the gradient for the input and apply it to the
+     * shared weights without any locking. Multiple threads may call this at the same time as
+     * long as each uses its own workspace; their updates race by design
+     * @param input The input Matrix, one input per column (usually a single column)
+     * @param label The expected output, one label per column
+     * @param dataset_size The size of the full dataset
+     * @param workspace The calling thread's workspace, from create_workspace
+     * @returns Returns the average loss across the columns of the input
+     */
+    float hogwild_train(const Matrix& input, const Matrix& label, size_t dataset_size,
+        Neural_Network_Workspace& workspace);
+
+    /**
+     * Create a workspace shaped for this Neural Network, e.g. one per thread for hogwild_train
+     * @param batch_size The number of examples the workspace should hold
+     * @returns Returns a pointer to a new Neural_Network_Workspace, owned by the caller
+     */
+    Neural_Network_Workspace* create_workspace(size_t batch_size) const;
+
     /**
      * Run inference using a trained Neural Network
      * @param input A Matrix instance containing one or more inputs. Each input should
@@ -192,7 +427,9 @@ public:
     Matrix* inference(const Matrix& input) const;
 
     /**
-     * Run inference using a trained Neural Network, putting its result into a defined Matrix
+     * Run inference using a trained Neural Network, putting its result into a defined Matrix.
+     * Scratch space comes from a context owned by the calling thread, so this is re-entrant
+     * and stops allocating once the thread has seen its widest batch
      * @param input A Matrix instance containing one or more inputs. Each input should
      * be in a separate column
      * @param destination Matrix to write the results to. This Matrix should be of dimensions
@@ -201,15 +438,84 @@ public:
     void inference(const Matrix& input, Matrix& destination) const;
 
     /**
-     * Create a deep copy of a Neural Network
+     * Run inference on raw uint8_t inputs, putting its result into a defined Matrix
+     * @param input A Byte_Matrix containing one input per column
+     * @param destination Matrix to write the results to, of dimensions [labels x inputs.size()]
+     * @param input_scale Factor every input is multiplied by, 1 / 255 for pixels
+     */
+    void inference(const Byte_Matrix& input, Matrix& destination,
+        float input_scale = NEURAL_NETWORK_BYTE_INPUT_SCALE) const;
+
+    /**
+     * Run inference with caller-owned scratch space. Doesn't allocate unless the batch is wider
+     * than the context has held before, and is safe to call from many threads on one network
+     * as long as each thread uses its own context
+     * @param input A Matrix containing one input per column
+     * @param destination Matrix to write the results to, of dimensions [labels x inputs.size()]
+     * @param context Scratch space from create_inference_context
+     */
+    void inference(const Matrix& input, Matrix& destination, Inference_Context& context) const;
+
+    /**
+     * Run inference on raw uint8_t inputs with caller-owned scratch space
+     * @param input A Byte_Matrix containing one input per column
+     * @param destination Matrix to write the results to, of dimensions [labels x inputs.size()]
+     * @param context Scratch space from create_inference_context
+     * @param input_scale Factor every input is multiplied by, 1 / 255 for pixels
+     */
+    void inference(const Byte_Matrix& input, Matrix& destination, Inference_Context& context,
+        float input_scale = NEURAL_NETWORK_BYTE_INPUT_SCALE) const;
+
+    /**
+     * Create an inference context shaped for this Neural Network, e.g. one per serving thread
+     * @param max_batch_size The largest number of inputs expected per inference call
+     * @returns Returns a pointer to a new Inference_Context, owned by the caller
      */
-    Neural_Network* clone(void);
+    Inference_Context* create_inference_context(size_t max_batch_size) const;
 
     /**
-     * Save a Neural Network to a file
+     * Get the number of layers, including the input layer
+     * @returns Returns the number of layers
+     */
+    size_t get_num_layers(void) const;
+
+    /**
+     * Get the number of neurons in a layer
+     * @param layer The layer index, with 0 being the input layer
+     * @returns Returns the number of neurons
+     */
+    size_t get_num_neurons(size_t layer) const;
+
+    /**
+     * Create an inference-only deep copy of a Neural Network, with the weights and biases but
+     * none of the training workspaces or threads
+     */
+    Neural_Network* clone(void) const;
+
+    /**
+     * Convert a trained network for serving: free the training workspaces, worker threads and
+     * any training Matrix in the layers. Training it afterwards is an error
+     */
+    void to_inference_only(void);
+
+    /**
+     * Check whether the network only holds what inference needs
+     * @returns Returns true if the network can't be trained
+     */
+    bool is_inference_only(void) const;
+
+    /**
+     * Save a Neural Network to a v2 model file, built in memory and written at once
      * @param path Path to save the Neural Network at
+     * @param dtype Storage type for the weights. Biases are always stored as fp32
      */
-    void save(const char* path) const;
+    void save(const char* path, Model_File_NS::Tensor_Dtype dtype = Model_File_NS::Tensor_Dtype::FP32) const;
+
+    /**
+     * Save a Neural Network to a v1 model file, for readers that predate v2
+     * @param path Path to save the Neural Network at
+     */
+    void save_v1(const char* path) const;
 };
 
 /**
@@ -219,6 +525,23 @@ public:
  */
 float sigmoid(float z);
 
+/**
+ * Calculate the sigmoid of a Matrix, storing in an existing Matrix. Uses the vectorized
+ * Fast_Math version at the precision set by Fast_Math_NS::set_precision
+ * @param target The Matrix to calculate the sigmoid of
+ * @param destination The destination Matrix to write to. May be the same as target
+ */
+void sigmoid(const Matrix& target, Matrix& destination);
+
+/**
+ * Add a bias column to every column of z and apply the sigmoid, in a single pass over z
+ * @param z The pre-activation Matrix. Updated in place with the bias added
+ * @param bias A single-column Matrix with one row per row of z
+ * @param destination The destination Matrix to write the activations to. May be the same as z,
+ * in which case z ends up holding the activations only
+ */
+void bias_sigmoid(Matrix& z, const Matrix& bias, Matrix& destination);
+
 /**
  * Calculate the softmax of a Matrix
  * @param target The Matrix to calculate the softmax of
@@ -247,6 +570,14 @@ Matrix* sigmoid_prime(const Matrix& target);
  */
 void sigmoid_prime(const Matrix& target, Matrix& destination);
 
+/**
+ * Multiply a Matrix by the sigmoid derivative, taken from cached sigmoid outputs rather than
+ * from z, in a single pass
+ * @param outputs The sigmoid outputs of the layer
+ * @param destination The Matrix to multiply in place, e.g. the error propagated back to the layer
+ */
+void multiply_sigmoid_prime(const Matrix& outputs, Matrix& destination);
+
 };
 
 #endif
@@ -55,6 +55,8 @@ private:
     Matrix* m_errors = NULL;
     Matrix* m_new_weights = NULL;
     Matrix* m_z = NULL;
+    /* Inference-only layers hold just the weights and biases, and refuse any training Matrix */
+    bool m_inference_only = false;
 
     /* Private functions */
 
@@ -72,6 +74,13 @@ private:
      */
     Matrix* get_matrix(Layer_Type layer_type);
 
+    /**
+     * Create a Neural_Network_Layer with no Matrix instances at all, for clone() to fill in
+     * @param num_neurons Number of neurons contained in this layer
+     * @param previous_layer_neurons Number of neurons in the previous layer
+     */
+    Neural_Network_Layer(size_t num_neurons, size_t previous_layer_neurons);
+
 public:
     /* Public functions */
 
@@ -80,7 +89,7 @@ public:
      * @param num_neurons Number of neurons contained in this layer
      * @param previous_layer_neurons Number of neurons in the previous layer
      * @param generate_biases True to generate biases, fale otherwise
-     * @param import True to setup empty layer and copy data into later
+     * @param import True to setup a layer with zeroed weights and biases to copy data into later
      * @returns Returns a new Neural_Network_Layer
      */
     Neural_Network_Layer(size_t num_neurons, size_t previous_layer_neurons, bool generate_biases, bool import);
@@ -108,6 +117,13 @@ public:
      */
     Neural_Network_Layer* clone(void) const;
 
+    /**
+     * Create a copy of a Neural_Network_Layer holding only the weights and biases
+     * @param inference_only True to leave out every training Matrix and mark the copy inference-only
+     * @returns Returns a pointer to a Neural_Network_Layer copy
+     */
+    Neural_Network_Layer* clone(bool inference_only) const;
+
     /**
      * Create a deep copy of a Neural_Network_Layer, storing in a predefined destination
      * @param destination Reference to a destination Neural_Network_Layer
@@ -143,16 +159,23 @@ public:
     void write_matrix(const Matrix& target, Layer_Type layer_type);
 
     /**
-     * Expand the bias Matrix for use during batch training
-     * @param batch_size The batch size being used -- this translates to the number of columns
-     * present in the updated bias Matrix
+     * Point the weights or biases at memory the layer doesn't own, e.g. a mapped model file,
+     * instead of its own copy. The memory must outlive the layer
+     * @param data Pointer to the row-major floats, in the shape the Matrix already has
+     * @param layer_type Layer_Type::WEIGHTS or Layer_Type::BIASES
+     */
+    void attach_matrix(float* data, Layer_Type layer_type);
+
+    /**
+     * Free every Matrix other than the weights and biases, and refuse to create them again
      */
-    void expand_bias(size_t batch_size);
+    void to_inference_only(void);
 
     /**
-     * Shrink the bias Matrix back to its normal use
+     * Check whether the layer only holds its weights and biases
+     * @returns Returns true if to_inference_only() was called or the layer was cloned that way
      */
-    void shrink_bias(void);
+    bool is_inference_only(void) const;
 };
 
 /**
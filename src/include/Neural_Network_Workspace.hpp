@@ -0,0 +1,190 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * Scratch space for a training step. Everything the forward and backward passes write
+ * (activations, errors and the gradients) lives in a single 64 byte aligned arena that is
+ * sized once from the layer topology and batch size. The Matrix instances handed out are
+ * views into that arena, so a training step touches the heap only when the batch grows past
+ * what the arena was sized for.
+ *
+ * Layer 0 is the input layer and has no entries; the caller's input Matrix is used
+ * directly instead.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef NEURAL_NETWORK_WORKSPACE_HPP
+#define NEURAL_NETWORK_WORKSPACE_HPP
+
+#define NEURAL_NETWORK_WORKSPACE_ALIGNMENT 64
+/* Number of Workspace_Type entries kept per layer */
+#define NEURAL_NETWORK_WORKSPACE_TYPES 4
+
+/* Standard dependencies */
+#include <cstdlib>
+#include <vector>
+
+/* Local dependencies */
+#include "Log.hpp"
+#include "Matrix.hpp"
+
+/* Using */
+using Matrix = Matrix_NS::Matrix<float>;
+
+/* Definitions */
+namespace Neural_Network_Workspace_NS {
+
+/* There is no z or activation derivative slice: the sigmoid derivative is taken from OUTPUTS */
+typedef enum {
+    /* Activations, [neurons x batch_size] */
+    OUTPUTS = 0,
+    /* Error (delta) for the layer, [neurons x batch_size] */
+    ERRORS = 1,
+    /* Weight gradient, [neurons x previous_layer_neurons] */
+    NABLA_W = 2,
+    /* Bias gradient, [neurons x 1] */
+    NABLA_B = 3
+} Workspace_Type;
+
+class Neural_Network_Workspace {
+private:
+    /* Private data elements */
+    std::vector<size_t> m_layer_info;
+    size_t m_batch_size = 0;
+    size_t m_max_batch_size = 0;
+    float* m_arena = NULL;
+    size_t m_arena_elements = 0;
+    /* Views into the arena, indexed by (layer * NEURAL_NETWORK_WORKSPACE_TYPES) + type */
+    Matrix** m_views = NULL;
+    /* Column of ones used to sum the error across a batch */
+    Matrix* m_ones = NULL;
+    /* Staging space for a slice of the caller's inputs and labels */
+    Matrix* m_inputs = NULL;
+    Matrix* m_labels = NULL;
+    /* Indices of the input rows that are nonzero, one slot per input neuron */
+    size_t* m_active_inputs = NULL;
+    /* Training steps taken with this workspace */
+    size_t m_steps = 0;
+
+    /* Private functions */
+
+    /**
+     * Allocate the arena for max_batch_size and point every view into it
+     * @param max_batch_size The largest batch the arena should hold
+     */
+    void allocate(size_t max_batch_size);
+
+    /**
+     * Point every view at its slice of the arena for the current batch size
+     */
+    void bind_views(void);
+
+public:
+    /* Public functions */
+
+    /**
+     * Create a new Neural_Network_Workspace
+     * @param layer_info Vector of size_t containing the sizes of each layer, including the input layer
+     * @param batch_size The number of examples processed per training step
+     */
+    Neural_Network_Workspace(const std::vector<size_t>& layer_info, size_t batch_size);
+
+    /**
+     * Destructor for Neural_Network_Workspace
+     */
+    ~Neural_Network_Workspace();
+
+    /* The views point into m_arena, so copying would leave two owners */
+    Neural_Network_Workspace(const Neural_Network_Workspace& target) = delete;
+    Neural_Network_Workspace& operator=(const Neural_Network_Workspace& target) = delete;
+
+    /**
+     * Get the batch size the views are currently shaped for
+     * @returns Returns the current batch size
+     */
+    size_t batch_size(void) const;
+
+    /**
+     * Get the number of layers, including the input layer
+     * @returns Returns the number of layers
+     */
+    size_t num_layers(void) const;
+
+    /**
+     * Check whether the workspace was built for a given topology
+     * @param layer_info Vector of size_t containing the sizes of each layer
+     * @returns Returns true if the topology matches
+     */
+    bool matches(const std::vector<size_t>& layer_info) const;
+
+    /**
+     * Reshape the workspace for a new batch size. Batches up to the largest size seen so far
+     * reuse the arena; larger batches reallocate it
+     * @param batch_size The number of examples in the next training step
+     * @returns Returns true if the arena had to be reallocated
+     */
+    bool resize(size_t batch_size);
+
+    /**
+     * Get a Matrix from the workspace
+     * @param workspace_type The Workspace_Type to get
+     * @param layer The layer index, starting at 1 for the first hidden layer
+     * @returns Returns a reference to the Matrix view
+     */
+    Matrix& get(Workspace_Type workspace_type, size_t layer);
+
+    /**
+     * Get a Matrix from the workspace
+     * @param workspace_type The Workspace_Type to get
+     * @param layer The layer index, starting at 1 for the first hidden layer
+     * @returns Returns a const reference to the Matrix view
+     */
+    const Matrix& get_const(Workspace_Type workspace_type, size_t layer) const;
+
+    /**
+     * Get a column of ones the size of the current batch
+     * @returns Returns a const reference to a [batch_size x 1] Matrix of ones
+     */
+    const Matrix& ones(void) const;
+
+    /**
+     * Get staging space for inputs, used when a batch is split and each part needs its
+     * columns copied out
+     * @returns Returns a reference to a [input_neurons x batch_size] Matrix
+     */
+    Matrix& inputs(void);
+
+    /**
+     * Get staging space for labels, used alongside inputs()
+     * @returns Returns a reference to a [output_neurons x batch_size] Matrix
+     */
+    Matrix& labels(void);
+
+    /**
+     * Get space for the indices of an input's nonzero rows, used to skip the weights of inputs
+     * that are zero
+     * @returns Returns a pointer to one size_t per input neuron
+     */
+    size_t* active_inputs(void);
+
+    /**
+     * Count a training step taken with this workspace, for work that is only done every few steps
+     * @returns Returns the number of steps counted so far, including this one
+     */
+    size_t count_step(void);
+};
+
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*  ________   ___   __    ______   ______   ______    ______   ______   ___   __    ______   ________   ___ __ __     
+ * /_______/\ /__/\ /__/\ /_____/\ /_____/\ /_____/\  /_____/\ /_____/\ /__/\ /__/\ /_____/\ /_______/\ /__//_//_/\    
+ * \::: _  \ \\::\_\\  \ \\:::_ \ \\::::_\/_\:::_ \ \ \::::_\/_\::::_\/_\::\_\\  \ \\::::_\/_\::: _  \ \\::\| \| \ \   
+ *  \::(_)  \ \\:. `-\  \ \\:\ \ \ \\:\/___/\\:(_) ) )_\:\/___/\\:\/___/\\:. `-\  \ \\:\/___/\\::(_)  \ \\:.      \ \  
+ *   \:: __  \ \\:. _    \ \\:\ \ \ \\::___\/_\: __ `\ \\_::._\:\\::___\/_\:. _    \ \\_::._\:\\:: __  \ \\:.\-/\  \ \ 
+ *    \:.\ \  \ \\. \`-\  \ \\:\/.:| |\:\____/\\ \ `\ \ \ /____\:\\:\____/\\. \`-\  \ \ /____\:\\:.\ \  \ \\. \  \  \ \
+ *     \__\/\__\/ \__\/ \__\/ \____/_/ \_____\/ \_\/ \_\/ \_____\/ \_____\/ \__\/ \__\/ \_____\/ \__\/\__\/ \__\/ \__\/    
+ *                                                                                                               
+ * Project: Basic Neural Network in C++
+ * @author : Samuel Andersen
+ * @version: 2026-10-17
+ *
+ * General Notes:
+ *
+ * A fixed-size pool of worker threads for running a batch of independent tasks. The
+ * calling thread takes part in the work, so a pool of size N starts N - 1 threads.
+ * run() blocks until every task has finished; tasks are claimed from a shared counter,
+ * so uneven tasks balance themselves across the threads.
+ *
+ * run_stealing() instead gives each thread a contiguous range of tasks. A thread works through
+ * its own range from the front, and once it runs dry steals the back half of another thread's
+ * remaining range, so neighbouring tasks mostly stay on the same thread.
+ *
+ * run() and run_stealing() do not allocate, which keeps them usable inside the allocation-free
+ * training step.
+ *
+ * TODO: Continue adding functionality 
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+/* Standard dependencies */
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+/* Local dependencies */
+#include "Log.hpp"
+
+namespace Thread_Pool_NS {
+
+/* A thread's remaining tasks, packed as (begin << 32) | end so the owner and thieves can
+ * update it with a single compare and swap. Padded so each thread's range has its own line */
+struct alignas(64) Task_Range {
+    std::atomic<uint64_t> range{0};
+};
+
+class Thread_Pool {
+private:
+    /* Private data elements */
+    size_t m_num_threads = 0;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_finished;
+
+    /* Bumped for every call to run(), which is what wakes the workers */
+    size_t m_generation = 0;
+    bool m_shutdown = false;
+    /* Number of workers that haven't finished the current generation */
+    size_t m_active_workers = 0;
+
+    /* The current batch of tasks */
+    void (*m_task)(void* context, size_t worker, size_t index) = NULL;
+    void* m_context = NULL;
+    size_t m_num_tasks = 0;
+    std::atomic<size_t> m_next_task{0};
+    /* Set for run_stealing(), which hands out tasks from m_ranges instead of m_next_task */
+    bool m_stealing = false;
+    Task_Range* m_ranges = NULL;
+
+    /* Private functions */
+
+    /**
+     * Main loop for each worker thread
+     * @param worker Index of the thread, from 1 since the caller of run() is thread 0
+     */
+    void worker_loop(size_t worker);
+
+    /**
+     * Claim and run tasks from the current batch until none are left
+     * @param worker Index of the calling thread
+     */
+    void drain(size_t worker);
+
+    /**
+     * Claim the next task from a thread's own range
+     * @param worker Index of the calling thread
+     * @param index Set to the claimed task
+     * @returns Returns true if a task was claimed
+     */
+    bool pop_task(size_t worker, size_t& index);
+
+    /**
+     * Steal the back half of another thread's range, keeping the first stolen task and making
+     * the rest the calling thread's new range
+     * @param worker Index of the calling thread
+     * @param index Set to the claimed task
+     * @returns Returns true if a task was stolen, false once every range is empty
+     */
+    bool steal_task(size_t worker, size_t& index);
+
+    /**
+     * Run a batch of tasks across the pool, blocking until they are all complete
+     * @param task Function to call for each task index, along with the index of the thread running it
+     * @param context Pointer handed to each call of task
+     * @param num_tasks Number of tasks, indexed [0, num_tasks)
+     * @param stealing True to split the tasks into per-thread ranges, false to use a shared counter
+     */
+    void execute(void (*task)(void* context, size_t worker, size_t index), void* context, size_t num_tasks,
+        bool stealing);
+
+    /**
+     * Adapter that lets execute() call any callable taking a task index without type erasure that allocates
+     * @param context Pointer to the callable
+     * @param worker Index of the thread running the task, unused
+     * @param index The task index
+     */
+    template <typename Function> static void invoke(void* context, size_t worker, size_t index) {
+        (void)worker;
+        (*(Function*)context)(index);
+    }
+
+    /**
+     * Adapter that lets execute() call any callable taking a thread and task index
+     * @param context Pointer to the callable
+     * @param worker Index of the thread running the task
+     * @param index The task index
+     */
+    template <typename Function> static void invoke_worker(void* context, size_t worker, size_t index) {
+        (*(Function*)context)(worker, index);
+    }
+
+public:
+    /* Public functions */
+
+    /**
+     * Create a new Thread_Pool
+     * @param num_threads Total number of threads to run tasks on, including the caller
+     */
+    Thread_Pool(size_t num_threads);
+
+    /**
+     * Destructor for Thread_Pool, joining all workers
+     */
+    ~Thread_Pool();
+
+    /* Workers hold a pointer to the pool, so it can't be copied or moved */
+    Thread_Pool(const Thread_Pool& target) = delete;
+    Thread_Pool& operator=(const Thread_Pool& target) = delete;
+
+    /**
+     * Get the number of threads tasks run on, including the caller
+     * @returns Returns the number of threads
+     */
+    size_t size(void) const;
+
+    /**
+     * Run func(index) for every index in [0, num_tasks) across the pool, blocking until
+     * all are complete. Calls from inside a task are not supported
+     * @param num_tasks Number of tasks
+     * @param func Callable taking a size_t task index
+     */
+    template <typename Function> void run(size_t num_tasks, Function& func) {
+        execute(invoke<Function>, (void*)&func, num_tasks, false);
+    }
+
+    /**
+     * Run func(worker, index) for every index in [0, num_tasks) across the pool with work
+     * stealing, blocking until all are complete. worker is in [0, size()) and no two tasks
+     * with the same worker run at once, so it can index per-thread state
+     * @param num_tasks Number of tasks, less than 2^32
+     * @param func Callable taking a size_t thread index and a size_t task index
+     */
+    template <typename Function> void run_stealing(size_t num_tasks, Function& func) {
+        execute(invoke_worker<Function>, (void*)&func, num_tasks, true);
+    }
+};
+
+/**
+ * Get the number of hardware threads available
+ * @returns Returns the number of hardware threads, at least 1
+ */
+size_t hardware_threads(void);
+
+};
+
+#endif
@@ -21,10 +21,13 @@
 /* Standard dependencies */
 #include <vector>
 #include <iostream>
+#include <signal.h>
 #include <sstream>
 #include <string>
+#include <string.h>
 
 /* Local dependencies */
+#include "Inference_Server.hpp"
 #include "Log.hpp"
 #include "MNIST_Training.hpp"
 #include "Neural_Network.hpp"
@@ -17,9 +17,116 @@
 
 #include "include/main.hpp"
 
+/* Server to stop when SIGINT or SIGTERM arrives */
+static Inference_Server_NS::Inference_Server* running_server = NULL;
+
+/**
+ * Stop the running server so it can finish its batch and clean up the socket
+ * @param signal The signal received
+ */
+static void handle_stop_signal(int signal) {
+
+    (void)signal;
+    if (running_server != NULL) { running_server->stop(); }
+}
+
+/**
+ * Load a model once and serve it over a Unix domain socket until interrupted
+ * @param argc Number of arguments, including the program name and mode
+ * @param argv serve <path to model> <path to socket> [max batch size] [max wait in microseconds]
+ * @returns Returns the exit code
+ */
+static int serve(int argc, char* argv[]) {
+
+    if (argc < 4) {
+        Log::log_message(Log::Log_Priority::ERROR, "main::serve",
+            "Usage: serve <path to model> <path to socket> [max batch size] [max wait in microseconds]");
+        return EXIT_FAILURE;
+    }
+
+    const size_t max_batch_size = (argc > 4) ? strtoul(argv[4], NULL, 10) : INFERENCE_SERVER_MAX_BATCH_SIZE;
+    const size_t max_wait_us = (argc > 5) ? strtoul(argv[5], NULL, 10) : INFERENCE_SERVER_MAX_WAIT_US;
+
+    Neural_Network_NS::Neural_Network nn(argv[2]);
+    Inference_Server_NS::Inference_Server server(nn, argv[3], max_batch_size, max_wait_us);
+
+    running_server = &server;
+    signal(SIGINT, handle_stop_signal);
+    signal(SIGTERM, handle_stop_signal);
+
+    server.run();
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    running_server = NULL;
+
+    Log::log_message(Log::Log_Priority::INFO, "main::serve",
+        std::format("Served {} requests in {} batches", server.requests_served(), server.batches_run()));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Check how many images of a dataset a saved model classifies correctly
+ * @param argc Number of arguments, including the program name and mode
+ * @param argv predict|threaded-predict <path to labels> <path to images> <images to predict> <path to model>
+ * [threads], with threaded-predict defaulting to every hardware thread and predict using one
+ * @returns Returns the exit code
+ */
+static int predict(int argc, char* argv[]) {
+
+    if (argc < 6) {
+        Log::log_message(Log::Log_Priority::ERROR, "main::predict",
+            std::format("Usage: {} <path to labels> <path to images> <images to predict> <path to model> [threads]",
+                argv[1]));
+        return EXIT_FAILURE;
+    }
+
+    size_t num_threads = 1;
+
+    if (strcmp(argv[1], "threaded-predict") == 0) {
+        num_threads = (argc > 6) ? strtoul(argv[6], NULL, 10) : Thread_Pool_NS::hardware_threads();
+    }
+
+    MNIST_Training_NS::predict_model(argv[2], argv[3], strtoul(argv[4], NULL, 10), argv[5], num_threads);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Measure single-image inference latency of a saved model
+ * @param argc Number of arguments, including the program name and mode
+ * @param argv latency <path to images> <path to model> [iterations]
+ * @returns Returns the exit code
+ */
+static int latency(int argc, char* argv[]) {
+
+    if (argc < 4) {
+        Log::log_message(Log::Log_Priority::ERROR, "main::latency",
+            std::format("Usage: {} <path to images> <path to model> [iterations]", argv[1]));
+        return EXIT_FAILURE;
+    }
+
+    size_t iterations = (argc > 4) ? strtoul(argv[4], NULL, 10) : 100000;
+    MNIST_Training_NS::benchmark_latency(argv[2], argv[3], iterations);
+
+    return EXIT_SUCCESS;
+}
 
 int main(int argc, char* argv[]) {
 
+    if (argc > 1 && strcmp(argv[1], "serve") == 0) {
+        return serve(argc, argv);
+    }
+
+    if (argc > 1 && (strcmp(argv[1], "predict") == 0 || strcmp(argv[1], "threaded-predict") == 0)) {
+        return predict(argc, argv);
+    }
+
+    if (argc > 1 && strcmp(argv[1], "latency") == 0) {
+        return latency(argc, argv);
+    }
+
     Log::log_message(Log::Log_Priority::WARNING, "main::main", "Hello");
 
     for (int i = 1; i < argc; ++i) {